@@ -0,0 +1,40 @@
+/* bench.h - Çekirdek içi mikro ölçümler (make BENCH=1) */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <types.h>
+
+/* Yüksek çözünürlüklü sayaç (CNTPCT_EL0) */
+static inline uint64_t bench_ticks(void) {
+    uint64_t t;
+    __asm__ volatile("isb\n"
+                     "mrs %0, cntpct_el0" : "=r"(t) : : "memory");
+    return t;
+}
+
+/* Sayaç frekansı (Hz) */
+static inline uint64_t bench_freq(void) {
+    uint64_t f;
+    __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(f));
+    return f;
+}
+
+/* PMU çevrim sayacını aç (PMCR_EL0.E, PMCNTENSET_EL0.C) */
+static inline void bench_cycles_init(void) {
+    __asm__ volatile("msr pmcr_el0, %0\n"
+                     "msr pmcntenset_el0, %1\n"
+                     "isb" : : "r"((uint64_t)((1 << 0) | (1 << 2))), "r"((uint64_t)1 << 31));
+}
+
+/* CPU çevrim sayısı (PMCCNTR_EL0) */
+static inline uint64_t bench_cycles(void) {
+    uint64_t c;
+    __asm__ volatile("isb\n"
+                     "mrs %0, pmccntr_el0" : "=r"(c) : : "memory");
+    return c;
+}
+
+/* Tüm ölçümleri çalıştır ve sonuçları UART'a yaz */
+void bench_run_all(void);
+
+#endif
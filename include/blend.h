@@ -0,0 +1,162 @@
+/* blend.h - Alpha karıştırma çekirdekleri (NEON, src/lib/blend.S) */
+#ifndef BLEND_H
+#define BLEND_H
+
+#include <types.h>
+#include <fb.h>
+
+/*
+ * Tüm karıştırmalar kanal başına t = fg*a + bg*(255-a) hesaplar ve
+ * t/255'i en yakın tamsayıya yuvarlar: (t + 128 + ((t + 128) >> 8)) >> 8.
+ * Bu, t <= 255*255 için bölmesiz ve tam doğrudur; NEON ve skaler yollar
+ * bit bit aynı sonucu verir. Sonuç pikselin alpha baytı her zaman 0xFF.
+ *
+ * NEON yolu 16 pikseli LD4 ile kanallarına ayırıp birlikte işler, 16'dan
+ * kısa kuyruğu piksel piksel aynı aritmetikle kapatır. make BLEND_SCALAR=1
+ * ile span fonksiyonları src/kernel/blend.c'deki skaler sürüme döner.
+ *
+ * RGB565 tamponda (make FB16=1) aynı yuvarlama 5/6 bitlik kanallarda
+ * yapılır (blend565_*, src/kernel/blend.c). Paletli tamponda (FB8=1)
+ * piksel paletten açılır, karıştırılır ve fb_color ile geri indekslenir
+ * (blend8_*). Grafik kodu fb_span_* ile tamponun biçimine uygun çekirdeği
+ * çağırır.
+ */
+
+/* t / 255, en yakına yuvarlanmış (t <= 65025) */
+static inline uint32_t blend_div255(uint32_t t) {
+    t += 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/* Tek piksel: bg üzerine fg, alpha ile */
+static inline uint32_t blend_pixel(uint32_t bg, uint32_t fg, uint8_t alpha) {
+    uint32_t inv = 255 - alpha;
+    uint32_t r = blend_div255(((fg >> 16) & 0xFF) * alpha + ((bg >> 16) & 0xFF) * inv);
+    uint32_t g = blend_div255(((fg >> 8) & 0xFF) * alpha + ((bg >> 8) & 0xFF) * inv);
+    uint32_t b = blend_div255((fg & 0xFF) * alpha + (bg & 0xFF) * inv);
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+/* Önçarpımlı kaynak tek piksel: kanal başına s + round(d*(255-sa)/255), doyumlu */
+static inline uint32_t blend_pixel_over(uint32_t bg, uint32_t src) {
+    uint32_t inv = 255 - (src >> 24);
+    uint32_t out = 0xFF000000;
+    for(int sh = 0; sh < 24; sh += 8) {
+        uint32_t c = ((src >> sh) & 0xFF) + blend_div255(((bg >> sh) & 0xFF) * inv);
+        out |= (c > 255 ? 255 : c) << sh;
+    }
+    return out;
+}
+
+/* n piksel: dst[i] = blend_pixel(dst[i], color, alpha) */
+void blend_span(uint32_t *dst, int n, uint32_t color, uint8_t alpha);
+
+/* Cam paneli: önce açıklaştır (c + (255-c)/4), sonra tint ile karıştır */
+void blend_span_glass(uint32_t *dst, int n, uint32_t tint, uint8_t alpha);
+
+/* Blit satırı: dst[i] = blend_pixel_over(dst[i], src[i]) */
+void blend_span_over(uint32_t *dst, const uint32_t *src, int n);
+
+/* Blit satırı, renk anahtarlı: src[i] != key ise dst[i] = src[i] */
+void blend_span_key(uint32_t *dst, const uint32_t *src, int n, uint32_t key);
+
+/*
+ * Dikey kutu bulanıklığı (kayan toplam), ARGB8888, kanal başına:
+ * dst[y] = round(sum(src[clamp(y-r .. y+r)]) / (2r+1)), bölme yerine
+ * (sum * m + 32768) >> 16, m = round(65536 / (2r+1)). w 4'ün katı
+ * (adım = w piksel), 1 <= r <= 127, dst != src.
+ */
+void blur_box_cols(uint32_t *dst, const uint32_t *src, int w, int h, int r);
+
+#ifdef CONFIG_FB16
+
+/* 565 piksel üzerine ARGB8888 renk, alpha ile (kanallar kendi bit derinliğinde) */
+static inline uint16_t blend565_pixel(uint16_t bg, uint32_t fg, uint8_t alpha) {
+    uint32_t inv = 255 - alpha;
+    uint32_t r = blend_div255(((fg >> 19) & 0x1F) * alpha + ((bg >> 11) & 0x1F) * inv);
+    uint32_t g = blend_div255(((fg >> 10) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * inv);
+    uint32_t b = blend_div255(((fg >> 3) & 0x1F) * alpha + (bg & 0x1F) * inv);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void blend565_span(uint16_t *dst, int n, uint32_t color, uint8_t alpha);
+void blend565_span_glass(uint16_t *dst, int n, uint32_t tint, uint8_t alpha);
+void blend565_span_over(uint16_t *dst, const uint32_t *src, int n);
+void blend565_span_key(uint16_t *dst, const uint32_t *src, int n, uint32_t key);
+void blend565_span_pack(uint16_t *dst, const uint32_t *src, int n);   /* ARGB8888 -> 565 kopya */
+
+#endif
+
+#ifdef CONFIG_FB8
+
+void blend8_span(uint8_t *dst, int n, uint32_t color, uint8_t alpha);
+void blend8_span_glass(uint8_t *dst, int n, uint32_t tint, uint8_t alpha);
+void blend8_span_over(uint8_t *dst, const uint32_t *src, int n);
+void blend8_span_key(uint8_t *dst, const uint32_t *src, int n, uint32_t key);
+void blend8_span_pack(uint8_t *dst, const uint32_t *src, int n);      /* ARGB8888 -> indeks */
+
+#endif
+
+/* --- Tampon biçimine göre span (graphics.c, transition.c) --- */
+
+static inline fb_pixel_t fb_blend_pixel(fb_pixel_t bg, uint32_t fg, uint8_t alpha) {
+#ifdef CONFIG_FB16
+    return blend565_pixel(bg, fg, alpha);
+#elif defined(CONFIG_FB8)
+    return fb_color(blend_pixel(fb_argb(bg), fg, alpha));
+#else
+    return blend_pixel(bg, fg, alpha);
+#endif
+}
+
+static inline void fb_span_blend(fb_pixel_t *dst, int n, uint32_t color, uint8_t alpha) {
+#ifdef CONFIG_FB16
+    blend565_span(dst, n, color, alpha);
+#elif defined(CONFIG_FB8)
+    blend8_span(dst, n, color, alpha);
+#else
+    blend_span(dst, n, color, alpha);
+#endif
+}
+
+static inline void fb_span_glass(fb_pixel_t *dst, int n, uint32_t tint, uint8_t alpha) {
+#ifdef CONFIG_FB16
+    blend565_span_glass(dst, n, tint, alpha);
+#elif defined(CONFIG_FB8)
+    blend8_span_glass(dst, n, tint, alpha);
+#else
+    blend_span_glass(dst, n, tint, alpha);
+#endif
+}
+
+static inline void fb_span_over(fb_pixel_t *dst, const uint32_t *src, int n) {
+#ifdef CONFIG_FB16
+    blend565_span_over(dst, src, n);
+#elif defined(CONFIG_FB8)
+    blend8_span_over(dst, src, n);
+#else
+    blend_span_over(dst, src, n);
+#endif
+}
+
+static inline void fb_span_key(fb_pixel_t *dst, const uint32_t *src, int n, uint32_t key) {
+#ifdef CONFIG_FB16
+    blend565_span_key(dst, src, n, key);
+#elif defined(CONFIG_FB8)
+    blend8_span_key(dst, src, n, key);
+#else
+    blend_span_key(dst, src, n, key);
+#endif
+}
+
+static inline void fb_span_copy(fb_pixel_t *dst, const uint32_t *src, int n) {
+#ifdef CONFIG_FB16
+    blend565_span_pack(dst, src, n);
+#elif defined(CONFIG_FB8)
+    blend8_span_pack(dst, src, n);
+#else
+    memcpy(dst, src, n * 4);
+#endif
+}
+
+#endif
@@ -0,0 +1,92 @@
+/* displist.h - Kalıcı çizim listesi (display list) ve frame farkı */
+#ifndef DISPLIST_H
+#define DISPLIST_H
+
+#include <types.h>
+
+/*
+ * Ekran kodu her frame tüm sahneyi "çizer", ama kayıt sırasında grafik
+ * fonksiyonları piksele dokunmaz: çağrı (op, dikdörtgen, renk, metin)
+ * olarak listeye eklenir. Frame sonunda her 32x32 karo için, o karoya
+ * değen komutların sıralı özeti (hash) çıkarılır ve önceki frame ile
+ * karşılaştırılır:
+ *   - Hiçbir karo değişmediyse raster ve sunum tamamen atlanır.
+ *   - Değişen karolar 64x64'lük kutulara (bin) toplanır, komutlar kutulara
+ *     dağıtılır ve kutular çekirdeklere paylaştırılır. Her kutu kendi
+ *     clip'iyle sadece ona değen komutları yeniden çizer (PROF=1 ile
+ *     kutu başına süre T satırlarında raporlanır).
+ *   - Kutuda opak komutlar (dikdörtgen, gradyan, blit) örtü sayılır;
+ *     altlarındaki komutların örtülen kısımları hiç yazılmaz.
+ * Liste taşarsa (ör. piksel piksel resim çizimi) frame doğrudan çizilir
+ * ve sonraki frame tamamen yeniden çizilir.
+ */
+
+#define DL_MAX_CMDS     1024
+#define DL_TEXT_ARENA   8192    /* Metinler frame boyunca burada kopyalanır */
+
+typedef enum {
+    DL_PIXEL,
+    DL_RECT,
+    DL_RECT_ALPHA,
+    DL_CLEAR,
+    DL_GRADIENT_BG,
+    DL_GRADIENT_RECT,
+    DL_GLASS,
+    DL_ROUNDED,
+    DL_ROUNDED_ALPHA,
+    DL_SHADOW,
+    DL_GLOW,
+    DL_LINE_H,
+    DL_LINE_V,
+    DL_TEXT,
+    DL_BLIT,
+    DL_BLIT_ALPHA,
+    DL_BLIT_KEY
+} DlOp;
+
+struct Surface;
+
+typedef void (*DlTextFn)(int x, int y, const char *text, uint32_t color);
+typedef int (*DlTextWidthFn)(const char *text);
+
+/* Kayıt sürüyor mu? (grafik fonksiyonları girişte sorar) */
+extern int displist_active;
+
+static inline int displist_recording(void) {
+    return displist_active;
+}
+
+/* Komut ekle; a/b op'a göre yarıçap, alpha, kalınlık vb. */
+void displist_record(DlOp op, int x, int y, int w, int h,
+                     uint32_t c0, uint32_t c1, int a, int b);
+
+/* Metin: kayıtta kopyalanır, kayıt yoksa fn doğrudan çağrılır */
+void displist_text(DlTextFn fn, DlTextWidthFn width, int height,
+                   int x, int y, const char *text, uint32_t color);
+
+/*
+ * Blit: yüzeyin alanları kopyalanır (çağıranın Surface'i geçici olabilir),
+ * pikseller değil. Özet pixels işaretçisi ve gen'den çıkar.
+ */
+void displist_blit(DlOp op, const struct Surface *src, int x, int y, uint32_t key);
+
+/*
+ * render()'ı kaydederek çalıştır, farkı çiz. Dönüş: 1 = draw_buffer
+ * değişti (swap gerekli), 0 = frame öncekiyle aynı.
+ */
+int displist_render(void (*render)(void));
+
+/* draw_buffer liste dışında değiştirildi: sonraki frame tamamen çizilsin */
+void displist_invalidate(void);
+
+/* Son frame'de yeniden çizilen karo sayısı (0-300) */
+uint32_t displist_raster_tiles(void);
+
+/*
+ * Son raster'da çizilen piksel başına yazım x100 (örtmeden sonra kalan
+ * komut alanlarından; 100 = her piksel bir kez). OVERDRAW=1 ile çizilen
+ * kutular ısı haritasıyla boyanır: 2 yazım mavi, 3 yeşil, 4 pembe, 5+ kırmızı.
+ */
+uint32_t displist_overdraw(void);
+
+#endif
@@ -0,0 +1,35 @@
+/* dma.h - BCM2837 genel amaçlı DMA denetleyicisi */
+#ifndef DMA_H
+#define DMA_H
+
+#include <types.h>
+
+/* Kullanılan tam (2D destekli) kanallar; firmware 0x7F35 maskesindekileri bırakır */
+#define DMA_CH_PRESENT      4   /* Back buffer -> framebuffer */
+#define DMA_CH_FILL         5   /* Düz renk doldurma */
+#define DMA_MAX_CHANNELS    7   /* 0-6 tam kanal, 7-14 "lite" (2D yok) */
+
+#define DMA_CHAIN_MAX       32  /* Kanal başına zincirdeki kontrol bloğu */
+
+/* DMA denetleyicisini hazırla, 2D satır sayımını sına (0 = tamam) */
+int dma_init(void);
+int dma_available(void);
+
+/*
+ * Kontrol bloğu zinciri: begin -> copy_2d / fill_2d ... -> submit
+ * Adresler ARM fiziksel adresidir; önbellek bakımı çağıranın görevidir
+ * (kaynak clean, hedef invalidate). Zincir doluysa add -1 döner.
+ */
+void dma_chain_begin(int ch);
+int dma_chain_copy_2d(int ch, void *dst, uint32_t dst_pitch,
+                      const void *src, uint32_t src_pitch,
+                      uint32_t width_bytes, uint32_t rows);
+int dma_chain_fill_2d(int ch, void *dst, uint32_t dst_pitch,
+                      uint32_t value, uint32_t width_bytes, uint32_t rows);
+void dma_chain_submit(int ch);  /* Beklemeden döner */
+
+/* Kanal hâlâ çalışıyor mu? / bitene kadar bekle (çekirdek 0'da wfi ile) */
+int dma_busy(int ch);
+void dma_wait(int ch);
+
+#endif
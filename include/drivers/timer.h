@@ -30,7 +30,11 @@ void clock_format_full(char *buffer);  /* "HH:MM:SS" formatı */
 void clock_format_date(char *buffer);  /* "DD/MM/YYYY" formatı */
 
 /* Gecikme fonksiyonları */
-void timer_wait_ms(uint32_t ms);
-void timer_wait_us(uint32_t us);
+void timer_wait_ms(uint32_t ms);    /* Çekirdek 0'da wfi ile uyur */
+void timer_wait_us(uint32_t us);    /* Kısa, meşgul bekleme */
+
+/* Mutlak zamana (tick) kadar wfi ile uyu, uyku süresini say */
+void timer_sleep_until(uint64_t target);
+uint64_t timer_idle_ticks(void);
 
 #endif
@@ -0,0 +1,78 @@
+/* fb.h - Çizim tamponunun piksel biçimi (ARGB8888, FB16=1 ile RGB565, FB8=1 ile paletli) */
+#ifndef FB_H
+#define FB_H
+
+#include <types.h>
+
+/*
+ * Çizim API'si renkleri her zaman 0xAARRGGBB alır; tampona yazılırken
+ * fb_color() ile tamponun biçimine çevrilir. RGB565'te piksel 2 bayttır:
+ * temizleme, karıştırma ve sunumun taşıdığı bayt yarıya iner, renk
+ * kanal başına 5/6/5 bite düşer (gradyanlar için FB16_DITHER=1).
+ *
+ * Paletli modda (FB8) piksel 1 bayt palet indeksidir. fb_color() rengi
+ * 4096 hücreli (RGB444) tablodan en yakın palet girişine çevirir; tablo
+ * palet değişince graphics.c'de yeniden kurulur. Palet düzeni graphics.h'de.
+ */
+#if defined(CONFIG_FB16) && defined(CONFIG_FB8)
+#error "FB16 ve FB8 birlikte secilemez"
+#endif
+
+#ifdef CONFIG_FB16
+#define FB_BPP          16
+typedef uint16_t fb_pixel_t;
+#elif defined(CONFIG_FB8)
+#define FB_BPP          8
+typedef uint8_t fb_pixel_t;
+
+extern uint32_t fb_palette[256];        /* Çizimde kullanılan palet (ARGB) */
+extern uint8_t fb_palette_map[4096];    /* RGB444 -> en yakın indeks */
+#else
+#define FB_BPP          32
+typedef uint32_t fb_pixel_t;
+#endif
+
+#define FB_BYTES        (FB_BPP / 8)
+#define FB_STRIDE       (SCREEN_WIDTH * FB_BYTES)   /* Çizim tamponu satır adımı */
+
+/* ARGB8888 -> tampon pikseli */
+static inline fb_pixel_t fb_color(uint32_t argb) {
+#ifdef CONFIG_FB16
+    return (fb_pixel_t)(((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F));
+#elif defined(CONFIG_FB8)
+    return fb_palette_map[((argb >> 12) & 0xF00) | ((argb >> 8) & 0xF0) | ((argb >> 4) & 0xF)];
+#else
+    return argb;
+#endif
+}
+
+/* Tampon pikseli -> ARGB8888 (565'te alt bitler üst bitlerle doldurulur) */
+static inline uint32_t fb_argb(fb_pixel_t p) {
+#ifdef CONFIG_FB16
+    uint32_t r = (p >> 11) & 0x1F;
+    uint32_t g = (p >> 5) & 0x3F;
+    uint32_t b = p & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+#elif defined(CONFIG_FB8)
+    return fb_palette[p];
+#else
+    return p;
+#endif
+}
+
+/* DMA dolgu deseni: 32 bitlik kelimede bir, iki veya dört piksel */
+static inline uint32_t fb_fill_word(uint32_t argb) {
+#ifdef CONFIG_FB16
+    uint32_t p = fb_color(argb);
+    return p | (p << 16);
+#elif defined(CONFIG_FB8)
+    return fb_color(argb) * 0x01010101u;
+#else
+    return argb;
+#endif
+}
+
+#endif
@@ -3,6 +3,7 @@
 #define FONTS_H
 
 #include "types.h"
+#include "displist.h"
 
 /* Tüm font varyantlarını dahil et */
 #include "font_inter_16.h"
@@ -33,34 +34,38 @@ typedef enum {
     FONT_WEIGHT_BOLD
 } FontWeight;
 
+/* Metin çizimi displist üzerinden (kayıt yoksa doğrudan çizer) */
+#define FONT_TEXT(font, height, x, y, text, color) \
+    displist_text(font##_draw_text, font##_text_width, height, x, y, text, color)
+
 /* Kolay kullanım makroları - varsayılan olarak medium kullan */
 
 /* 16px fontlar */
-#define draw_text_16(x, y, text, color)         font_inter_16_medium_draw_text(x, y, text, color)
-#define draw_text_16_regular(x, y, text, color) font_inter_16_draw_text(x, y, text, color)
-#define draw_text_16_medium(x, y, text, color)  font_inter_16_medium_draw_text(x, y, text, color)
-#define draw_text_16_bold(x, y, text, color)    font_inter_16_bold_draw_text(x, y, text, color)
+#define draw_text_16(x, y, text, color)         FONT_TEXT(font_inter_16_medium, FONT_INTER_16_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_16_regular(x, y, text, color) FONT_TEXT(font_inter_16, FONT_INTER_16_HEIGHT, x, y, text, color)
+#define draw_text_16_medium(x, y, text, color)  FONT_TEXT(font_inter_16_medium, FONT_INTER_16_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_16_bold(x, y, text, color)    FONT_TEXT(font_inter_16_bold, FONT_INTER_16_BOLD_HEIGHT, x, y, text, color)
 #define text_width_16(text)                      font_inter_16_medium_text_width(text)
 
 /* 20px fontlar */
-#define draw_text_20(x, y, text, color)         font_inter_20_medium_draw_text(x, y, text, color)
-#define draw_text_20_regular(x, y, text, color) font_inter_20_draw_text(x, y, text, color)
-#define draw_text_20_medium(x, y, text, color)  font_inter_20_medium_draw_text(x, y, text, color)
-#define draw_text_20_bold(x, y, text, color)    font_inter_20_bold_draw_text(x, y, text, color)
+#define draw_text_20(x, y, text, color)         FONT_TEXT(font_inter_20_medium, FONT_INTER_20_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_20_regular(x, y, text, color) FONT_TEXT(font_inter_20, FONT_INTER_20_HEIGHT, x, y, text, color)
+#define draw_text_20_medium(x, y, text, color)  FONT_TEXT(font_inter_20_medium, FONT_INTER_20_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_20_bold(x, y, text, color)    FONT_TEXT(font_inter_20_bold, FONT_INTER_20_BOLD_HEIGHT, x, y, text, color)
 #define text_width_20(text)                      font_inter_20_medium_text_width(text)
 
 /* 24px fontlar */
-#define draw_text_24(x, y, text, color)         font_inter_24_medium_draw_text(x, y, text, color)
-#define draw_text_24_regular(x, y, text, color) font_inter_24_draw_text(x, y, text, color)
-#define draw_text_24_medium(x, y, text, color)  font_inter_24_medium_draw_text(x, y, text, color)
-#define draw_text_24_bold(x, y, text, color)    font_inter_24_bold_draw_text(x, y, text, color)
+#define draw_text_24(x, y, text, color)         FONT_TEXT(font_inter_24_medium, FONT_INTER_24_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_24_regular(x, y, text, color) FONT_TEXT(font_inter_24, FONT_INTER_24_HEIGHT, x, y, text, color)
+#define draw_text_24_medium(x, y, text, color)  FONT_TEXT(font_inter_24_medium, FONT_INTER_24_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_24_bold(x, y, text, color)    FONT_TEXT(font_inter_24_bold, FONT_INTER_24_BOLD_HEIGHT, x, y, text, color)
 #define text_width_24(text)                      font_inter_24_medium_text_width(text)
 
 /* 32px fontlar */
-#define draw_text_32(x, y, text, color)         font_inter_32_medium_draw_text(x, y, text, color)
-#define draw_text_32_regular(x, y, text, color) font_inter_32_draw_text(x, y, text, color)
-#define draw_text_32_medium(x, y, text, color)  font_inter_32_medium_draw_text(x, y, text, color)
-#define draw_text_32_bold(x, y, text, color)    font_inter_32_bold_draw_text(x, y, text, color)
+#define draw_text_32(x, y, text, color)         FONT_TEXT(font_inter_32_medium, FONT_INTER_32_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_32_regular(x, y, text, color) FONT_TEXT(font_inter_32, FONT_INTER_32_HEIGHT, x, y, text, color)
+#define draw_text_32_medium(x, y, text, color)  FONT_TEXT(font_inter_32_medium, FONT_INTER_32_MEDIUM_HEIGHT, x, y, text, color)
+#define draw_text_32_bold(x, y, text, color)    FONT_TEXT(font_inter_32_bold, FONT_INTER_32_BOLD_HEIGHT, x, y, text, color)
 #define text_width_32(text)                      font_inter_32_medium_text_width(text)
 
 /* Font yükseklikleri */
@@ -3,14 +3,26 @@
 #define GRAPHICS_H
 
 #include <types.h>
+#include <fb.h>
 
 /* Framebuffer değişkenleri (extern) */
 extern uint32_t screen_width, screen_height, screen_pitch;
+extern uint32_t screen_virtual_height;     /* Sayfa çevirme için 2x yükseklik */
 extern uint8_t *framebuffer;
 
-/* Çift tamponlama için back buffer */
+/*
+ * Aktif çizim alanı. SCREEN_WIDTH x SCREEN_HEIGHT tamponların en büyük
+ * boyutudur; graphics_set_scale() ile çizim daha küçük bir alanda yapılıp
+ * GPU tarafından ekrana büyütülebilir. Kırpma ve tam ekran çizimler bu
+ * boyutlara uyar.
+ */
+#define GFX_WIDTH       ((int)screen_width)
+#define GFX_HEIGHT      ((int)screen_height)
+
+/* Çift tamponlama için back buffer (piksel biçimi fb.h, satır adımı FB_STRIDE) */
 extern uint8_t *draw_buffer;      /* Çizim yapılan buffer */
 extern uint8_t *display_buffer;   /* Görüntülenen buffer */
+extern int graphics_page_flip;    /* 1 = sanal ofset ile sayfa çevirme, 0 = kopya */
 
 /* Temel çizim fonksiyonları */
 void draw_pixel(int x, int y, uint32_t color);
@@ -27,13 +39,111 @@ void draw_rect_alpha(int x, int y, int w, int h, uint32_t color, uint8_t alpha);
 void draw_glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha);
 void draw_rounded_rect(int x, int y, int w, int h, int radius, uint32_t color);
 void draw_rounded_rect_alpha(int x, int y, int w, int h, int radius, uint32_t color, uint8_t alpha);
+void draw_circle(int cx, int cy, int radius, uint32_t color);                   /* Kenarlar yumuşatılmış */
+void draw_circle_alpha(int cx, int cy, int radius, uint32_t color, uint8_t alpha);
 void draw_shadow(int x, int y, int w, int h, int blur, uint8_t intensity);
 void draw_glow(int x, int y, int w, int h, uint32_t color, int size);
 void draw_line_h(int x, int y, int w, uint32_t color);
 void draw_line_v(int x, int y, int h, uint32_t color);
 
+/*
+ * Yüzey (surface): ekran dışında duran piksel dizisi, blit kaynağı.
+ * Pikseller framebuffer ile aynı ARGB8888 düzeninde (bellekte B,G,R,A).
+ * stride bayt cinsinden; bir sprite sayfasının parçası için pixels alt
+ * dikdörtgenin başına, stride sayfanınkine ayarlanmış bir yüzey kurulur.
+ * İçerik değişince gen artırılmalı: displist blit'i işaretçi ve gen ile
+ * tanır, pikselleri taramaz.
+ */
+typedef enum {
+    SURFACE_ARGB8888 = 0,
+    SURFACE_FB                  /* Çizim tamponunun biçimi (fb.h), sadece blit() */
+} SurfaceFormat;
+
+typedef struct Surface {
+    int w, h;
+    int stride;             /* Satırlar arası bayt */
+    int format;             /* SurfaceFormat */
+    uint32_t *pixels;
+    uint32_t gen;           /* İçerik sürümü */
+} Surface;
+
+/* Blit: (x, y)'ye kırpılarak kopyala; kırpma çağrı başına bir kez yapılır */
+void blit(const Surface *src, int x, int y);
+void blit_alpha(const Surface *src, int x, int y);                  /* Önçarpımlı alpha: d = s + d*(255-sa)/255 */
+void blit_colorkey(const Surface *src, int x, int y, uint32_t key); /* key'e eşit pikseller atlanır */
+
 /* Çift tamponlama */
-void graphics_init_buffers(void);
+int graphics_init_buffers(void);
 void graphics_swap_buffers(void);
+int graphics_set_scale(int div);        /* 1 = 640x480, 2 = 320x240, 4 = 160x120 ... (hata: -1) */
+
+/* Kirli bölge takibi (32x32 karolar): swap sadece değişen alanı sunar */
+void graphics_mark_dirty(int x, int y, int w, int h);   /* draw_buffer'a doğrudan yazanlar için */
+void graphics_invalidate(void);                         /* Sonraki swap tüm ekranı sunsun */
+uint32_t graphics_presented_bytes(void);                /* Son swap'ta taşınan bayt */
+
+/*
+ * Palet (make FB8=1, 8 bpp indeksli tampon):
+ *   0-215    6x6x6 renk küpü (kanal adımı 51)
+ *   216-231  16 gri tonu
+ *   232-255  tema yuvaları (theme.c renklerini buraya yazar)
+ * fb_color() her rengi en yakın girişe eşler; tema renkleri kendi
+ * yuvalarına birebir düşer. Bir girişi değiştirmek o indeksle çizilmiş
+ * her pikseli yeniden boyamadan değiştirir (palet animasyonu). Diğer
+ * modlarda palet fonksiyonları bir şey yapmaz / -1 döner.
+ */
+#define PAL_CUBE_FIRST      0
+#define PAL_GRAY_FIRST      216
+#define PAL_GRAY_COUNT      16
+#define PAL_THEME_FIRST     232
+#define PAL_THEME_COUNT     24
+
+void graphics_set_palette(int first, int count, const uint32_t *colors);
+int graphics_palette_blend(uint32_t color, uint8_t alpha);     /* Ekrandaki palet color'a doğru; 0 = asıl palet */
+
+/*
+ * Clip dikdörtgeni: tüm çizim fonksiyonları ve glif çiziciler bu alanın
+ * dışına yazmaz. push mevcut clip'i (x, y, w, h) ile kesiştirir, pop geri
+ * alır (en fazla 8 seviye); set/reset yığını boşaltır, push/pop ile
+ * iç içe kullanılmaz. Kayıt sırasında (displist) push'lanan clip
+ * komutun etki alanına işlenir ve raster'da uygulanır.
+ */
+void graphics_set_clip(int x, int y, int w, int h);
+void graphics_reset_clip(void);                          /* Tam ekran */
+int graphics_push_clip(int x, int y, int w, int h);     /* -1: yığın dolu, clip değişmedi */
+void graphics_pop_clip(void);
+int graphics_clip_rect(int *x, int *y, int *w, int *h); /* Clip'e kırp; boşsa 0 */
+int graphics_clip_test(int x, int y, int w, int h);     /* Clip'e değiyor mu? */
+
+/*
+ * Karo modu (displist): begin/end arasında çizimler çekirdeklere dağıtılmış
+ * karolarda, her biri kendi clip'iyle yapılır. Çağıran karoları önceden
+ * graphics_mark_dirty ile işaretler; bu arada işaretleme ve DMA kapalıdır.
+ */
+void graphics_tiles_begin(void);
+void graphics_tiles_end(void);
+
+/*
+ * Ekran dışı çizim: begin/end arasındaki çizimler ayrı bir tam ekran
+ * tampona, (x, y, w, h) clip'iyle ve kaydedilmeden yapılır. end alanı
+ * out'a (SURFACE_FB, w x h) kopyalar; out 0 olabilir. Karo raster'ı
+ * dışında ve iç içe olmadan kullanılır (compositor, cam önbelleği).
+ */
+int graphics_offscreen_begin(int x, int y, int w, int h);     /* -1: bellek yok / alan boş */
+void graphics_offscreen_end(Surface *out);
+
+/*
+ * Buzlu cam önbelleği (displist): key panelin altındaki komutların
+ * özetidir (0 olamaz). prepare, replay() ile alt komutları ayrı bir
+ * tampona çizdirip bulanıklığı hesaplar; karo raster'ı sonra
+ * graphics_glass_panel ile sadece önbellekten büyütür. begin_frame'den
+ * sonra cached'in bulduğu ve prepare'in doldurduğu girişler sonraki
+ * begin_frame'e kadar çıkarılmaz.
+ */
+void graphics_glass_begin_frame(void);
+int graphics_glass_cached(uint32_t key);
+void graphics_glass_prepare(int x, int y, int w, int h, uint32_t tint, uint8_t alpha,
+                            uint32_t key, void (*replay)(void *arg), void *arg);
+void graphics_glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha, uint32_t key);
 
 #endif
@@ -8,11 +8,32 @@
 void uart_init(void);
 void init_screen(void);
 
-/* UART fonksiyonları */
+/* UART fonksiyonları (uart_irq_init sonrası yazma bloklamaz) */
+#define UART_TX_BUF_SIZE    4096    /* Bayt, 2'nin kuvveti */
+#define UART_RX_BUF_SIZE    512     /* Kayıt (8 bayt, toplam 4KB), 2'nin kuvveti */
+
+/* Gelen bayt ve geliş zamanı (system timer, mikrosaniye alt 32 bit) */
+typedef struct {
+    uint32_t time;
+    uint8_t c;
+} UartRxEvent;
+
+void uart_irq_init(void);
+void uart_sync(void);
 void uart_puts(char *s);
 void uart_hex(unsigned int d);
+void uart_dec(unsigned int d);
 int uart_getc(void);
 int uart_available(void);
+int uart_rx_peek(int index, UartRxEvent *ev);
+void uart_rx_drop(int count);
+uint32_t uart_rx_dropped_count(void);
+
+/* Mailbox sorguları */
+int hw_fb_setup(uint32_t width, uint32_t height);      /* Fiziksel boyut; GPU ekrana ölçekler */
+int hw_set_virtual_offset(uint32_t x, uint32_t y);
+int hw_get_arm_memory(uint32_t *base, uint32_t *size);
+int hw_set_palette(int first, int count, const uint32_t *colors);    /* ARGB, en fazla 256 */
 
 /* Yardımcı fonksiyonlar */
 void delay(int32_t count);
@@ -0,0 +1,96 @@
+/* irq.h - İstisna vektörleri ve kesme (IRQ) dağıtımı */
+#ifndef IRQ_H
+#define IRQ_H
+
+#include <types.h>
+
+/*
+ * Kesme numaraları
+ *   0-63  : BCM2835 çevre birimi kesmeleri (0x3F00B200 denetleyicisi)
+ *   64-75 : BCM2836 ARM local kesmeleri (0x40000000, çekirdek başına)
+ */
+#define IRQ_SYSTIMER_1      1       /* System timer karşılaştırıcı 1 */
+#define IRQ_SYSTIMER_3      3       /* System timer karşılaştırıcı 3 */
+#define IRQ_USB             9
+#define IRQ_DMA0            16      /* DMA kanal n: IRQ_DMA0 + n (0-12) */
+#define IRQ_GPIO0           49
+#define IRQ_GPIO1           50
+#define IRQ_GPIO2           51
+#define IRQ_GPIO3           52
+#define IRQ_UART0           57
+#define IRQ_EMMC            62
+
+#define IRQ_LOCAL_BASE      64
+#define IRQ_CNTPS           (IRQ_LOCAL_BASE + 0)    /* Generic timer (secure) */
+#define IRQ_CNTPNS          (IRQ_LOCAL_BASE + 1)    /* Generic timer (non-secure) */
+#define IRQ_CNTHP           (IRQ_LOCAL_BASE + 2)
+#define IRQ_CNTV            (IRQ_LOCAL_BASE + 3)
+#define IRQ_MAILBOX0        (IRQ_LOCAL_BASE + 4)    /* Çekirdek mailbox 0-3 */
+#define IRQ_MAILBOX1        (IRQ_LOCAL_BASE + 5)
+#define IRQ_MAILBOX2        (IRQ_LOCAL_BASE + 6)
+#define IRQ_MAILBOX3        (IRQ_LOCAL_BASE + 7)
+#define IRQ_GPU             (IRQ_LOCAL_BASE + 8)    /* 0-63 buradan dağıtılır */
+#define IRQ_PMU             (IRQ_LOCAL_BASE + 9)
+#define IRQ_AXI             (IRQ_LOCAL_BASE + 10)
+#define IRQ_LOCAL_TIMER     (IRQ_LOCAL_BASE + 11)
+#define IRQ_COUNT           (IRQ_LOCAL_BASE + 12)
+
+/* start.s'teki çerçeve düzeniyle aynı */
+typedef struct {
+    uint64_t x[31];
+    uint64_t elr;
+    uint64_t spsr;
+    uint64_t fpsr;
+    uint64_t fpcr;
+    uint64_t pad;
+    uint64_t q[64];
+} ExceptionFrame;
+
+/* Kesme işleyicisi (kaynağı temizlemek işleyicinin görevidir) */
+typedef void (*irq_handler_fn)(int irq, void *arg);
+
+/* Denetleyicileri sıfırla, bu çekirdekte IRQ'ları aç */
+void irq_init(void);
+
+/* İşleyici kaydet / kaldır (fn = NULL) */
+void irq_register(int irq, irq_handler_fn fn, void *arg);
+
+/* Kaynağı aç / kapat (local kaynaklar çağıran çekirdekte) */
+void irq_enable(int irq);
+void irq_disable(int irq);
+
+/* Çekirdekler arası mailbox (local kesme) */
+void irq_mailbox_send(int core, int mbox, uint32_t bits);
+uint32_t irq_mailbox_clear(int mbox);
+
+/* ARM local timer: 38.4MHz kristal, reload 28 bit */
+void irq_local_timer_start(uint32_t reload);
+void irq_local_timer_stop(void);
+void irq_local_timer_ack(void);
+
+/* start.s'ten çağrılır */
+void irq_dispatch(ExceptionFrame *frame);
+void exception_handler(ExceptionFrame *frame, uint64_t type);
+
+/* CPU IRQ maskesi */
+static inline void irq_enable_cpu(void) {
+    __asm__ volatile("msr daifclr, #2" : : : "memory");
+}
+
+static inline void irq_disable_cpu(void) {
+    __asm__ volatile("msr daifset, #2" : : : "memory");
+}
+
+/* Kritik bölge: maskeyi kaydet ve kapat / eski haline getir */
+static inline uint64_t irq_save(void) {
+    uint64_t flags;
+    __asm__ volatile("mrs %0, daif\n"
+                     "msr daifset, #2" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void irq_restore(uint64_t flags) {
+    __asm__ volatile("msr daif, %0" : : "r"(flags) : "memory");
+}
+
+#endif
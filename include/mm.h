@@ -0,0 +1,41 @@
+/* mm.h - Fiziksel sayfa ayırıcı, kernel heap (kmalloc) ve arena */
+#ifndef MM_H
+#define MM_H
+
+#include <types.h>
+
+#define PAGE_SIZE       4096
+#define PAGE_SHIFT      12
+
+/* Sayfa ayırıcıyı başlat (__bss_end .. ARM/GPU bölünmesi) */
+void mm_init(void);
+
+/* Ardışık sayfa ayır / bırak (sayfa hizalı, sıfırlanmaz) */
+void *page_alloc(size_t pages);
+void page_free(void *addr, size_t pages);
+
+/* İstatistik (sayfa cinsinden) */
+size_t page_total(void);
+size_t page_free_count(void);
+
+/*
+ * Genel amaçlı heap: 2KB'a kadar boyut sınıflı slab'lar, daha büyükleri
+ * doğrudan sayfalardan. Dönen adres en az 16 bayt hizalıdır.
+ */
+void *kmalloc(size_t size);
+void *kzalloc(size_t size);
+void kfree(void *ptr);
+
+/* Arena: tek blok, sırayla ayır, toptan sıfırla (dekoder geçici belleği) */
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+} Arena;
+
+int arena_init(Arena *arena, size_t size);     /* 0: başarılı */
+void *arena_alloc(Arena *arena, size_t size, size_t align);
+void arena_reset(Arena *arena);
+void arena_destroy(Arena *arena);
+
+#endif
@@ -0,0 +1,34 @@
+/* mmu.h - MMU, sayfa tabloları ve önbellek yönetimi */
+#ifndef MMU_H
+#define MMU_H
+
+#include <types.h>
+
+/* MAIR_EL1 bellek tipi indeksleri */
+#define MMU_ATTR_DEVICE     0   /* Device-nGnRE (çevre birimleri) */
+#define MMU_ATTR_NORMAL     1   /* Normal, Write-Back önbellekli (DRAM) */
+#define MMU_ATTR_NORMAL_NC  2   /* Normal, önbelleksiz (framebuffer, write-combining) */
+
+/* Bellek haritası */
+#define MMU_PERIPH_BASE     0x3F000000UL
+#define MMU_LOCAL_BASE      0x40000000UL
+#define MMU_BLOCK_SIZE      0x200000UL      /* 2MB blok (L2) */
+
+/* MMU başlatma (start.s'ten, kernel_main'den önce çağrılır) */
+void mmu_init(void);
+
+/* Sayfa tablolarını mevcut çekirdekte etkinleştir */
+void mmu_enable(void);
+
+/* Bir bölgenin bellek tipini değiştir (2MB blok hassasiyetinde) */
+void mmu_map_range(uintptr_t base, size_t size, int attr);
+
+/* MMU aktif mi? */
+int mmu_is_enabled(void);
+
+/* Önbellek bakım fonksiyonları (GPU/DMA ile paylaşılan bellek için) */
+void dcache_clean_range(const void *addr, size_t len);       /* Yaz (clean) */
+void dcache_invalidate_range(const void *addr, size_t len);  /* Geçersiz kıl */
+void dcache_flush_range(const void *addr, size_t len);       /* Yaz + geçersiz kıl */
+
+#endif
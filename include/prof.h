@@ -0,0 +1,64 @@
+/* prof.h - Cortex-A53 PMU tabanlı bölge (zone) profilleyici (make PROF=1) */
+#ifndef PROF_H
+#define PROF_H
+
+#include <types.h>
+
+/*
+ * Kullanım: bir bloğun başında
+ *     PROF_ZONE("swap");
+ * Blok bitince (cleanup) çevrim, L1D refill ve komut sayıları bölgeye
+ * eklenir. kernel_main her frame sonunda prof_frame_end() çağırır ve
+ * birikenler UART'a CSV olarak yazılır (tools/prof_plot.py):
+ *     N,<id>,<ad>                                  bölge tanımı (bir kez)
+ *     F,<frame>,<frame_sayisi>,<toplam_cycle>      aralık başlığı
+ *     P,<frame>,<id>,<cagri>,<cycle>,<l1d_refill>,<komut>
+ *     T,<frame>,<sutun>,<satir>,<ns/frame>...     karo başına raster süresi
+ * Sadece çekirdek 0 ölçülür; iç içe bölgeler kapsayıcıdır.
+ */
+
+#define PROF_MAX_ZONES          16
+#define PROF_MAX_TILES          128 /* prof_tiles en fazla karo */
+#define PROF_FRAME_INTERVAL     8   /* Kaç frame'de bir yazılır (UART bütçesi) */
+
+#ifdef CONFIG_PROF
+
+typedef struct {
+    const char *name;
+    int id;                 /* İlk kullanımda atanır */
+} ProfZoneDef;
+
+typedef struct {
+    ProfZoneDef *zone;
+    uint64_t cycles;
+    uint64_t l1d_refill;
+    uint64_t instructions;
+} ProfScope;
+
+void prof_init(void);
+ProfScope prof_zone_begin(ProfZoneDef *zone);
+void prof_zone_end(ProfScope *scope);
+void prof_frame_end(void);
+
+/* Frame'in karo süreleri (CNTPCT tick, satır satır cols*rows değer) */
+void prof_tiles(const uint32_t *ticks, int cols, int rows);
+
+#define PROF_CONCAT_(a, b)  a##b
+#define PROF_CONCAT(a, b)   PROF_CONCAT_(a, b)
+
+#define PROF_ZONE(zname) \
+    static ProfZoneDef PROF_CONCAT(prof_def_, __LINE__) = { zname, -1 }; \
+    ProfScope PROF_CONCAT(prof_scope_, __LINE__) \
+        __attribute__((cleanup(prof_zone_end))) = \
+        prof_zone_begin(&PROF_CONCAT(prof_def_, __LINE__))
+
+#else
+
+#define prof_init()         do { } while(0)
+#define prof_frame_end()    do { } while(0)
+#define prof_tiles(t, c, r) do { } while(0)
+#define PROF_ZONE(zname)    do { } while(0)
+
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+/* smp.h - Çok çekirdek (SMP) başlatma ve iş gönderme */
+#ifndef SMP_H
+#define SMP_H
+
+#include <types.h>
+
+#define SMP_MAX_CORES   4
+#define SMP_STACK_SIZE  (64 * 1024)     /* Çekirdek başına yığın */
+
+/* Çekirdekte çalışacak iş */
+typedef void (*smp_job_fn)(void *arg);
+
+/* İkincil çekirdekleri (1-3) spin-table üzerinden uyandır */
+void smp_init(void);
+
+/* Boştaki ikincil çekirdeğin wfe yerine çağırdığı fonksiyon (1 = iş yaptı) */
+typedef int (*smp_idle_fn)(void);
+void smp_set_idle(smp_idle_fn fn);
+
+/* Çalışan çekirdek sayısı (çekirdek 0 dahil) */
+int smp_num_cores(void);
+
+/* Bu kodu çalıştıran çekirdeğin numarası */
+static inline int smp_core_id(void) {
+    uint64_t mpidr;
+    __asm__ volatile("mrs %0, mpidr_el1" : "=r"(mpidr));
+    return (int)(mpidr & 0xFF);
+}
+
+/*
+ * fn(arg)'ı verilen çekirdekte başlat. Çekirdek meşgulse önceki işin
+ * bitmesini bekler. Çekirdek 0 veya çevrimdışı çekirdek verilirse iş
+ * çağıranda hemen çalıştırılır. Hata: -1
+ */
+int smp_run_on(int core, smp_job_fn fn, void *arg);
+
+/* Çekirdekte hâlâ iş çalışıyor mu? */
+int smp_is_busy(int core);
+
+/* Tek bir çekirdeğin işini bekle */
+void smp_wait_core(int core);
+
+/* Tüm ikincil çekirdeklerin işlerini bekle */
+void smp_wait(void);
+
+/* wfe ile bekleyen çekirdekleri uyandır (yazılanlar önce görünür olur) */
+static inline void smp_sev(void) {
+    __asm__ volatile("dsb ish\n"
+                     "sev" : : : "memory");
+}
+
+/* Basit döndürme kilidi (kesme işleyicilerinde kullanılmamalı) */
+typedef struct {
+    uint32_t locked;
+} Spinlock;
+
+static inline void spin_lock(Spinlock *lock) {
+    while(__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE)) {
+        while(__atomic_load_n(&lock->locked, __ATOMIC_RELAXED)) {
+            __asm__ volatile("wfe");
+        }
+    }
+}
+
+static inline void spin_unlock(Spinlock *lock) {
+    __atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+    smp_sev();
+}
+
+#endif
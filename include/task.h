@@ -0,0 +1,51 @@
+/* task.h - Çekirdekler arası iş çalma (work-stealing) görev sistemi */
+#ifndef TASK_H
+#define TASK_H
+
+#include <types.h>
+
+#define TASK_DEQUE_SIZE     256     /* Çekirdek başına kuyruk (2'nin kuvveti) */
+#define TASK_MAX_CHUNKS     64      /* parallel_for en fazla parça */
+
+typedef void (*task_fn)(void *arg);
+
+/* [begin, end) aralığını işleyen parallel_for gövdesi */
+typedef void (*task_range_fn)(int begin, int end, void *arg);
+
+/* Bekleme grubu: bitmemiş görev sayısı */
+typedef struct {
+    uint32_t pending;
+} TaskGroup;
+
+/*
+ * Görev sistemini başlat. smp_init()'ten sonra çağrılmalı; boştaki
+ * ikincil çekirdekler wfe yerine diğer kuyruklardan görev çalar.
+ * Görevler kesme işleyicilerinden oluşturulmamalı.
+ */
+void task_init(void);
+
+/* Çağıran çekirdeğin varsayılan grubuna görev ekle */
+void task_spawn(task_fn fn, void *arg);
+
+/* Varsayılan gruptaki görevler bitene kadar bekle (beklerken görev çalıştırır) */
+void task_group_wait(void);
+
+/* Belirli bir gruba görev ekle / grubu bekle */
+void task_spawn_in(TaskGroup *group, task_fn fn, void *arg);
+void task_wait(TaskGroup *group);
+
+/*
+ * [begin, end) aralığını en az grain büyüklüğünde parçalara bölüp
+ * çekirdeklere dağıt. Döndüğünde tüm parçalar bitmiştir.
+ */
+void parallel_for(int begin, int end, int grain, task_range_fn fn, void *arg);
+
+/* Bir görev çalıştırmayı dene (kendi kuyruğu, sonra çalma); 1 = çalıştı */
+int task_run_one(void);
+
+/* İstatistik: çekirdeğin çalıştırdığı / çaldığı görev sayısı */
+uint32_t task_stat_executed(int core);
+uint32_t task_stat_stolen(int core);
+void task_stat_reset(void);
+
+#endif
@@ -0,0 +1,91 @@
+/* trace.h - Kilitsiz ikili iz (trace) halkası, UART loglarının yerine */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <types.h>
+
+/*
+ * Sıcak yollarda uart_puts yerine TRACE_*(olay, a0, a1) kullanılır:
+ * kayıt (zaman damgası, olay, iki argüman) çekirdeğin halkasına ~onlarca
+ * çevrimde yazılır. trace_drain() boşta kalan frame süresinde kayıtları
+ * UART'a "~" + 16 baytlık kaydın hex hali olarak döker; okunabilir metne
+ * tools/trace_decode.py çevirir (olay biçimleri aşağıdaki yorumlardan).
+ *
+ * Derleme zamanı seviye: make TRACE_LEVEL=n (varsayılan TRACE_LVL_INFO).
+ * Seviyenin üstündeki çağrılar tamamen derlenmez.
+ */
+
+#define TRACE_LVL_NONE      0
+#define TRACE_LVL_ERROR     1
+#define TRACE_LVL_WARN      2
+#define TRACE_LVL_INFO      3
+#define TRACE_LVL_DEBUG     4
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL         TRACE_LVL_INFO
+#endif
+
+#define TRACE_RING_SIZE     1024    /* Çekirdek başına kayıt (2'nin kuvveti) */
+
+/* Olaylar: yorumdaki biçim trace_decode.py tarafından okunur (%0 = a0, %1 = a1) */
+typedef enum {
+    TR_NONE = 0,            /* - */
+    TR_DROPPED,             /* Halka doldu, %0 kayit kayboldu (cekirdek %1) */
+
+    /* SD kart */
+    TR_SD_READ = 0x10,      /* SD read_block lba=%0 buf=%1 */
+    TR_SD_READ_DONE,        /* SD read_block OK lba=%0 */
+    TR_SD_UNALIGNED,        /* SD buffer 4 bayt hizali degil buf=%1 */
+    TR_SD_TIMEOUT,          /* SD zaman asimi lba=%0 asama=%1 (0=veri 1=READ_RDY 2=DATA_DONE) */
+    TR_SD_CMD_FAIL,         /* SD komut hatasi lba=%0 cmd=%1 */
+
+    /* FAT32 */
+    TR_FAT_OPEN = 0x20,     /* FAT32 open cluster=%0 size=%1 */
+    TR_FAT_OPEN_FAIL,       /* FAT32 open basarisiz neden=%0 (1=dizin 2=bulunamadi) */
+    TR_FAT_DIR_ENTRY,       /* FAT32 dizin girisi ilk=%0 attr=%1 */
+    TR_FAT_LFN,             /* FAT32 LFN seq=%0 chk=%1 */
+    TR_FAT_READ,            /* FAT32 read fd=%0 size=%1 */
+    TR_FAT_SECTOR,          /* FAT32 sektor=%0 pos=%1 */
+    TR_FAT_READ_DONE,       /* FAT32 read bitti fd=%0 okunan=%1 */
+    TR_FAT_READ_FAIL,       /* FAT32 read sd hatasi sektor=%0 */
+
+    /* PNG */
+    TR_PNG_CHUNK = 0x30,    /* PNG chunk type=%0 len=%1 */
+    TR_PNG_HEADER,          /* PNG IHDR w=%0 h=%1 */
+    TR_PNG_FORMAT,          /* PNG depth=%0 color=%1 */
+    TR_PNG_IDAT,            /* PNG IDAT toplam=%0 */
+    TR_PNG_INFLATE,         /* PNG inflate girdi=%0 cikti=%1 */
+    TR_PNG_INFLATE_BLOCK,   /* INFLATE blok bfinal=%0 btype=%1 */
+    TR_PNG_ROW,             /* PNG satir y=%0 filtre=%1 */
+    TR_PNG_BAD_FILTER,      /* PNG gecersiz filtre=%0 y=%1 */
+
+    TR_EVENT_COUNT
+} TraceEvent;
+
+/* 16 baytlık kayıt (trace_decode.py ile aynı düzen) */
+typedef struct {
+    uint32_t timestamp;     /* CNTPCT_EL0 alt 32 bit */
+    uint16_t event;
+    uint8_t  core;
+    uint8_t  level;
+    uint32_t arg0;
+    uint32_t arg1;
+} TraceRecord;
+
+void trace_init(void);
+void trace_emit(int level, int event, uint32_t arg0, uint32_t arg1);
+
+/* Kayıtları UART'a dök; deadline (system timer us) geçmeden durur, 0 = hepsi */
+void trace_drain(uint64_t deadline);
+
+#define TRACE(lvl, ev, a0, a1) \
+    do { \
+        if((lvl) <= TRACE_LEVEL) trace_emit((lvl), (ev), (uint32_t)(a0), (uint32_t)(a1)); \
+    } while(0)
+
+#define TRACE_ERR(ev, a0, a1)   TRACE(TRACE_LVL_ERROR, ev, a0, a1)
+#define TRACE_WARN(ev, a0, a1)  TRACE(TRACE_LVL_WARN, ev, a0, a1)
+#define TRACE_INFO(ev, a0, a1)  TRACE(TRACE_LVL_INFO, ev, a0, a1)
+#define TRACE_DBG(ev, a0, a1)   TRACE(TRACE_LVL_DEBUG, ev, a0, a1)
+
+#endif
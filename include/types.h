@@ -24,18 +24,10 @@
 /* Yol boyutu */
 #define MAX_PATH 512
 
-/* Inline memcpy ve memset */
-static inline void *memcpy(void *dest, const void *src, size_t n) {
-    uint8_t *d = (uint8_t*)dest;
-    const uint8_t *s = (const uint8_t*)src;
-    while(n--) *d++ = *s++;
-    return dest;
-}
-
-static inline void *memset(void *s, int c, size_t n) {
-    uint8_t *p = (uint8_t*)s;
-    while(n--) *p++ = (uint8_t)c;
-    return s;
-}
+/* libk bellek fonksiyonları (src/lib/string.S, NEON/LDP-STP) */
+void *memcpy(void *dest, const void *src, size_t n);
+void *memset(void *s, int c, size_t n);
+void *memmove(void *dest, const void *src, size_t n);
+int memcmp(const void *a, const void *b, size_t n);
 
 #endif
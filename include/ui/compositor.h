@@ -0,0 +1,45 @@
+/* compositor.h - Katmanlı ekran çizimi, durağan katmanlar için saklı yüzeyler */
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <types.h>
+#include <graphics.h>
+
+/*
+ * Ekran kendini katmanlar halinde tanımlar:
+ *   - LAYER_STATIC: arka plan gibi sadece temaya bağlı içerik. Bir kez
+ *     ekran dışında çizilip saklanır, her frame tek blit ile basılır.
+ *   - LAYER_CHROME: başlık/kenar çubuğu gibi yarı durağan içerik. key()
+ *     değişince yeniden çizilir (ör. seçili kategori, scroll).
+ *   - LAYER_DYNAMIC: her frame draw() ile doğrudan çizilir.
+ * Saklı katmanlar tema değişince (compositor_invalidate) ve ekran boyutu
+ * değişince yeniden çizilir. Saklı katman opaktır: alanı önce siyaha
+ * boyanır, altındaki katmanlar görünmez. Alan ekranın içinde olmalıdır.
+ * Bellek yoksa katman her frame doğrudan çizilir.
+ */
+typedef enum {
+    LAYER_STATIC,
+    LAYER_CHROME,
+    LAYER_DYNAMIC
+} LayerKind;
+
+typedef struct {
+    LayerKind kind;
+    int x, y, w, h;             /* Saklı katmanın alanı (DYNAMIC'te kullanılmaz) */
+    void (*draw)(void);
+    uint32_t (*key)(void);      /* Sadece CHROME */
+
+    /* Compositor'a ait */
+    Surface surf;               /* SURFACE_FB */
+    uint32_t drawn_key;
+    uint32_t drawn_epoch;
+    int drawn_w, drawn_h;       /* Çizildiği andaki ekran boyutu */
+} Layer;
+
+/* Katmanları sırayla (alttan üste) çiz */
+void compositor_draw(Layer *layers, int count);
+
+/* Tüm saklı katmanları geçersiz kıl (tema değişti) */
+void compositor_invalidate(void);
+
+#endif
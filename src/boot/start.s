@@ -2,19 +2,31 @@
 .section ".text.boot"
 
 .global _start
+.global _secondary_start
 
 _start:
-    /* Sadece Çekirdek 0 çalışsın, diğerlerini uyutalım (RPi Zero 2W 4 çekirdekli) */
+    /* Çekirdek 0 kernel'i başlatır, diğerleri smp_init() çağrısını bekler */
     mrs     x0, mpidr_el1
     and     x0, x0, #0xFF
     cbz     x0, master
-    b       hang
+
+    /* Tüm çekirdekleri buraya gönderen yükleyiciler için spin-table'ı
+       kendimiz bekleyelim (0xD8 + 8*çekirdek, firmware armstub8 gibi) */
+    mov     x1, #0xD8
+spin:
+    wfe
+    ldr     x2, [x1, x0, lsl #3]
+    cbz     x2, spin
+    br      x2
 
 hang:
     wfe
     b       hang
 
 master:
+    /* EL2/EL3'ten EL1'e in (MMU ve önbellekler EL1 rejimiyle yönetilir) */
+    bl      drop_to_el1
+
     /* Stack Pointer'ı (Yığını) ayarla */
     ldr     x0, =_start
     mov     sp, x0
@@ -28,6 +40,238 @@ master:
     cmp     x0, x1
     b.lt    1b
 
-2:  /* Kernel'e zıpla! */
+2:  /* Sayfa tablolarını kur, MMU ve I/D önbellekleri aç */
+    bl      mmu_init
+
+    /* Kernel'e zıpla! */
     bl      kernel_main
-    b       hang
\ No newline at end of file
+    b       hang
+
+/* İkincil çekirdek girişi (smp_init spin-table'a yazar) */
+_secondary_start:
+    bl      drop_to_el1
+
+    /* Çekirdeğe ait yığın (smp_core_stack[çekirdek]) */
+    mrs     x0, mpidr_el1
+    and     x0, x0, #0xFF
+    ldr     x1, =smp_core_stack
+    ldr     x2, [x1, x0, lsl #3]
+    mov     sp, x2
+
+    /* Çekirdek 0'ın kurduğu sayfa tablolarıyla MMU'yu aç */
+    bl      mmu_enable
+
+    mrs     x0, mpidr_el1
+    and     x0, x0, #0xFF
+    bl      smp_secondary_main
+    b       hang
+
+/* EL1'e düş ve çağırana EL1'de dön (x0, x1 bozulur, yığın gerekmez) */
+drop_to_el1:
+    mrs     x0, CurrentEL
+    and     x0, x0, #0xC
+    cmp     x0, #0xC
+    b.ne    1f
+
+    /* EL3: önbellek tutarlılığı için CPUECTLR_EL1.SMPEN */
+    mrs     x1, s3_1_c15_c2_1
+    orr     x1, x1, #(1 << 6)
+    msr     s3_1_c15_c2_1, x1
+
+    /* EL3 -> EL2: Non-secure, HVC açık, alt seviye AArch64 */
+    mov     x1, #0x5B1
+    msr     scr_el3, x1
+    mov     x1, #0x3C9              /* DAIF maskeli, EL2h */
+    msr     spsr_el3, x1
+    adr     x1, 1f
+    msr     elr_el3, x1
+    eret
+
+1:  mrs     x0, CurrentEL
+    and     x0, x0, #0xC
+    cmp     x0, #0x8
+    b.ne    2f
+
+    /* EL2 -> EL1: sayaçlara EL1 erişimi, EL1 AArch64, FP/SIMD tuzağı yok */
+    mrs     x1, cnthctl_el2
+    orr     x1, x1, #3
+    msr     cnthctl_el2, x1
+    msr     cntvoff_el2, xzr
+    mov     x1, #(1 << 31)
+    msr     hcr_el2, x1
+    mov     x1, #0x33FF
+    msr     cptr_el2, x1
+    msr     hstr_el2, xzr
+    mrs     x1, pmcr_el0            /* PMU: tüm sayaçlar EL1'e, tuzak yok */
+    ubfx    x1, x1, #11, #5
+    msr     mdcr_el2, x1
+    mov     x1, #0x0800             /* SCTLR_EL1 RES1 bitleri, MMU kapalı */
+    movk    x1, #0x30D0, lsl #16
+    msr     sctlr_el1, x1
+    mov     x1, #0x3C5              /* DAIF maskeli, EL1h */
+    msr     spsr_el2, x1
+    adr     x1, 2f
+    msr     elr_el2, x1
+    eret
+
+2:  /* EL1: FP/SIMD erişimini aç (derleyici float için FP kullanır) */
+    mov     x1, #(3 << 20)
+    msr     cpacr_el1, x1
+
+    /* İstisna vektör tablosu */
+    ldr     x1, =vectors
+    msr     vbar_el1, x1
+    isb
+    ret
+
+/*
+ * İstisna vektörleri
+ * Çerçeve düzeni (ExceptionFrame, irq.h ile aynı olmalı):
+ *   0..247  x0-x30, 248 elr, 256 spsr, 264 fpsr, 272 fpcr, 288.. q0-q31
+ */
+.equ FRAME_SIZE, 800
+.equ FRAME_Q,    288
+
+.macro SAVE_CONTEXT
+    sub     sp, sp, #FRAME_SIZE
+    stp     x0, x1, [sp, #0]
+    stp     x2, x3, [sp, #16]
+    SAVE_CONTEXT_REST
+.endm
+
+/* x4 ve sonrası (x0/x1 geçici olarak kullanılır, x2 korunur) */
+.macro SAVE_CONTEXT_REST
+    stp     x4, x5, [sp, #32]
+    stp     x6, x7, [sp, #48]
+    stp     x8, x9, [sp, #64]
+    stp     x10, x11, [sp, #80]
+    stp     x12, x13, [sp, #96]
+    stp     x14, x15, [sp, #112]
+    stp     x16, x17, [sp, #128]
+    stp     x18, x19, [sp, #144]
+    stp     x20, x21, [sp, #160]
+    stp     x22, x23, [sp, #176]
+    stp     x24, x25, [sp, #192]
+    stp     x26, x27, [sp, #208]
+    stp     x28, x29, [sp, #224]
+    mrs     x0, elr_el1
+    stp     x30, x0, [sp, #240]
+    mrs     x0, spsr_el1
+    mrs     x1, fpsr
+    stp     x0, x1, [sp, #256]
+    mrs     x0, fpcr
+    str     x0, [sp, #272]
+    add     x0, sp, #FRAME_Q
+    stp     q0, q1, [x0, #0]
+    stp     q2, q3, [x0, #32]
+    stp     q4, q5, [x0, #64]
+    stp     q6, q7, [x0, #96]
+    stp     q8, q9, [x0, #128]
+    stp     q10, q11, [x0, #160]
+    stp     q12, q13, [x0, #192]
+    stp     q14, q15, [x0, #224]
+    stp     q16, q17, [x0, #256]
+    stp     q18, q19, [x0, #288]
+    stp     q20, q21, [x0, #320]
+    stp     q22, q23, [x0, #352]
+    stp     q24, q25, [x0, #384]
+    stp     q26, q27, [x0, #416]
+    stp     q28, q29, [x0, #448]
+    stp     q30, q31, [x0, #480]
+.endm
+
+.macro RESTORE_CONTEXT
+    add     x0, sp, #FRAME_Q
+    ldp     q0, q1, [x0, #0]
+    ldp     q2, q3, [x0, #32]
+    ldp     q4, q5, [x0, #64]
+    ldp     q6, q7, [x0, #96]
+    ldp     q8, q9, [x0, #128]
+    ldp     q10, q11, [x0, #160]
+    ldp     q12, q13, [x0, #192]
+    ldp     q14, q15, [x0, #224]
+    ldp     q16, q17, [x0, #256]
+    ldp     q18, q19, [x0, #288]
+    ldp     q20, q21, [x0, #320]
+    ldp     q22, q23, [x0, #352]
+    ldp     q24, q25, [x0, #384]
+    ldp     q26, q27, [x0, #416]
+    ldp     q28, q29, [x0, #448]
+    ldp     q30, q31, [x0, #480]
+    ldr     x0, [sp, #272]
+    msr     fpcr, x0
+    ldp     x0, x1, [sp, #256]
+    msr     spsr_el1, x0
+    msr     fpsr, x1
+    ldp     x30, x0, [sp, #240]
+    msr     elr_el1, x0
+    ldp     x0, x1, [sp, #0]
+    ldp     x2, x3, [sp, #16]
+    ldp     x4, x5, [sp, #32]
+    ldp     x6, x7, [sp, #48]
+    ldp     x8, x9, [sp, #64]
+    ldp     x10, x11, [sp, #80]
+    ldp     x12, x13, [sp, #96]
+    ldp     x14, x15, [sp, #112]
+    ldp     x16, x17, [sp, #128]
+    ldp     x18, x19, [sp, #144]
+    ldp     x20, x21, [sp, #160]
+    ldp     x22, x23, [sp, #176]
+    ldp     x24, x25, [sp, #192]
+    ldp     x26, x27, [sp, #208]
+    ldp     x28, x29, [sp, #224]
+    add     sp, sp, #FRAME_SIZE
+.endm
+
+/* Beklenmeyen istisna: tip numarasıyla C'ye git, geri dönülmez
+   (vektör girdisi 32 komut, tam kayıt exc_entry'de) */
+.macro VECTOR_UNHANDLED type
+    .align 7
+    sub     sp, sp, #FRAME_SIZE
+    stp     x0, x1, [sp, #0]
+    stp     x2, x3, [sp, #16]
+    mov     x2, #\type
+    b       exc_entry
+.endm
+
+.macro VECTOR_IRQ
+    .align 7
+    b       irq_entry
+.endm
+
+.align 11
+vectors:
+    /* Mevcut EL, SP_EL0 */
+    VECTOR_UNHANDLED 0
+    VECTOR_UNHANDLED 1
+    VECTOR_UNHANDLED 2
+    VECTOR_UNHANDLED 3
+    /* Mevcut EL, SP_ELx (kernel burada çalışır) */
+    VECTOR_UNHANDLED 4
+    VECTOR_IRQ
+    VECTOR_UNHANDLED 6
+    VECTOR_UNHANDLED 7
+    /* Alt EL, AArch64 */
+    VECTOR_UNHANDLED 8
+    VECTOR_UNHANDLED 9
+    VECTOR_UNHANDLED 10
+    VECTOR_UNHANDLED 11
+    /* Alt EL, AArch32 */
+    VECTOR_UNHANDLED 12
+    VECTOR_UNHANDLED 13
+    VECTOR_UNHANDLED 14
+    VECTOR_UNHANDLED 15
+
+exc_entry:
+    SAVE_CONTEXT_REST
+    mov     x0, sp
+    mov     x1, x2
+    bl      exception_handler
+    b       hang
+
+irq_entry:
+    SAVE_CONTEXT
+    mov     x0, sp
+    bl      irq_dispatch
+    RESTORE_CONTEXT
+    eret
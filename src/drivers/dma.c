@@ -0,0 +1,249 @@
+/* dma.c - BCM2837 DMA: 2D kontrol bloğu zincirleri, kesme ile bitiş */
+#include <drivers/dma.h>
+#include <hw.h>
+#include <irq.h>
+#include <mmu.h>
+#include <smp.h>
+
+/* DMA Register adresleri */
+#define MMIO_BASE           0x3F000000
+#define DMA_BASE            (MMIO_BASE + 0x7000UL)
+
+#define DMA_CS(ch)          ((volatile uint32_t*)(DMA_BASE + 0x100 * (ch) + 0x00))
+#define DMA_CONBLK_AD(ch)   ((volatile uint32_t*)(DMA_BASE + 0x100 * (ch) + 0x04))
+#define DMA_DEBUG(ch)       ((volatile uint32_t*)(DMA_BASE + 0x100 * (ch) + 0x20))
+#define DMA_INT_STATUS      ((volatile uint32_t*)(DMA_BASE + 0xFE0))
+#define DMA_ENABLE          ((volatile uint32_t*)(DMA_BASE + 0xFF0))
+
+/* CS bitleri */
+#define CS_ACTIVE           (1u << 0)
+#define CS_END              (1u << 1)   /* 1 yazınca temizlenir */
+#define CS_INT              (1u << 2)   /* 1 yazınca temizlenir */
+#define CS_ERROR            (1u << 8)
+#define CS_PRIORITY(p)      ((uint32_t)(p) << 16)
+#define CS_PANIC_PRIO(p)    ((uint32_t)(p) << 20)
+#define CS_WAIT_WRITES      (1u << 28)
+#define CS_RESET            (1u << 31)
+
+/* TI (transfer bilgisi) bitleri */
+#define TI_INTEN            (1u << 0)
+#define TI_TDMODE           (1u << 1)   /* 2D: TXFR_LEN = YLENGTH:XLENGTH */
+#define TI_WAIT_RESP        (1u << 3)
+#define TI_DEST_INC         (1u << 4)
+#define TI_DEST_WIDTH       (1u << 5)   /* 128 bit yazma */
+#define TI_SRC_INC          (1u << 8)
+#define TI_SRC_WIDTH        (1u << 9)   /* 128 bit okuma */
+#define TI_BURST(n)         ((uint32_t)(n) << 12)
+
+#define DEBUG_CLEAR         0x7         /* Okuma/FIFO/son-okuma hataları */
+
+/* GPU'nun gördüğü adres: L2'yi atlayan (önbelleksiz) takma ad */
+#define BUS_ADDR(p)         ((uint32_t)(uintptr_t)(p) | 0xC0000000u)
+
+/* Donanım kontrol bloğu (32 bayt hizalı) */
+typedef struct {
+    uint32_t ti;
+    uint32_t source_ad;
+    uint32_t dest_ad;
+    uint32_t txfr_len;
+    uint32_t stride;
+    uint32_t nextconbk;
+    uint32_t reserved[2];
+} DmaControlBlock;
+
+/* Blok + doldurma deseni: tek önbellek satırı */
+typedef struct {
+    DmaControlBlock cb;
+    uint32_t pattern[4];
+    uint32_t pad[4];
+} __attribute__((aligned(64))) DmaSlot;
+
+typedef struct {
+    DmaSlot slots[DMA_CHAIN_MAX];
+    int count;
+} DmaChannel;
+
+static DmaChannel channels[DMA_MAX_CHANNELS];
+static int dma_ready = 0;
+
+/*
+ * 2D modda satır sayısı: BCM2835 belgesine göre donanım YLENGTH + 1 satır
+ * aktarır, QEMU ise YLENGTH satır. dma_init() küçük bir aktarımla ölçer.
+ */
+static uint32_t ylength_bias = 1;
+
+/* Kesme yalnızca dma_wait()'teki wfi'yi uyandırır; durum CS'den okunur */
+static void dma_irq(int irq, void *arg) {
+    (void)arg;
+    *DMA_CS(irq - IRQ_DMA0) = CS_INT;
+}
+
+void dma_chain_begin(int ch) {
+    channels[ch].count = 0;
+}
+
+static DmaSlot *dma_chain_add(int ch) {
+    DmaChannel *chan = &channels[ch];
+    if(chan->count >= DMA_CHAIN_MAX) return 0;
+
+    DmaSlot *slot = &chan->slots[chan->count];
+    if(chan->count > 0) {
+        chan->slots[chan->count - 1].cb.nextconbk = BUS_ADDR(&slot->cb);
+    }
+    chan->count++;
+
+    slot->cb.nextconbk = 0;
+    slot->cb.reserved[0] = 0;
+    slot->cb.reserved[1] = 0;
+    return slot;
+}
+
+static uint32_t txfr_2d(uint32_t width_bytes, uint32_t rows) {
+    uint32_t ylength = rows - ylength_bias;
+    return (ylength << 16) | (width_bytes & 0xFFFF);
+}
+
+int dma_chain_copy_2d(int ch, void *dst, uint32_t dst_pitch,
+                      const void *src, uint32_t src_pitch,
+                      uint32_t width_bytes, uint32_t rows) {
+    if(rows == 0 || width_bytes == 0) return 0;
+
+    DmaSlot *slot = dma_chain_add(ch);
+    if(!slot) return -1;
+
+    slot->cb.ti = TI_TDMODE | TI_WAIT_RESP | TI_SRC_INC | TI_DEST_INC |
+                  TI_SRC_WIDTH | TI_DEST_WIDTH | TI_BURST(8);
+    slot->cb.source_ad = BUS_ADDR(src);
+    slot->cb.dest_ad = BUS_ADDR(dst);
+    slot->cb.txfr_len = txfr_2d(width_bytes, rows);
+    /* Adım: satır sonundan sonraki satırın başına (D_STRIDE:S_STRIDE) */
+    slot->cb.stride = ((dst_pitch - width_bytes) << 16) | ((src_pitch - width_bytes) & 0xFFFF);
+    return 0;
+}
+
+int dma_chain_fill_2d(int ch, void *dst, uint32_t dst_pitch,
+                      uint32_t value, uint32_t width_bytes, uint32_t rows) {
+    if(rows == 0 || width_bytes == 0) return 0;
+
+    DmaSlot *slot = dma_chain_add(ch);
+    if(!slot) return -1;
+
+    /* Kaynak artmaz: 16 baytlık desen tekrar tekrar okunur */
+    for(int i = 0; i < 4; i++) {
+        slot->pattern[i] = value;
+    }
+    slot->cb.ti = TI_TDMODE | TI_WAIT_RESP | TI_DEST_INC |
+                  TI_SRC_WIDTH | TI_DEST_WIDTH | TI_BURST(8);
+    slot->cb.source_ad = BUS_ADDR(slot->pattern);
+    slot->cb.dest_ad = BUS_ADDR(dst);
+    slot->cb.txfr_len = txfr_2d(width_bytes, rows);
+    slot->cb.stride = (dst_pitch - width_bytes) << 16;
+    return 0;
+}
+
+void dma_chain_submit(int ch) {
+    DmaChannel *chan = &channels[ch];
+    if(chan->count == 0) return;
+
+    /* Zincirin sonu kesme üretir */
+    chan->slots[chan->count - 1].cb.ti |= TI_INTEN;
+
+    /* DMA önbelleği görmez: blokları belleğe yaz */
+    dcache_clean_range(chan->slots, chan->count * sizeof(DmaSlot));
+
+    *DMA_CS(ch) = CS_END | CS_INT;
+    *DMA_DEBUG(ch) = DEBUG_CLEAR;
+    *DMA_CONBLK_AD(ch) = BUS_ADDR(&chan->slots[0].cb);
+    *DMA_CS(ch) = CS_ACTIVE | CS_PRIORITY(8) | CS_PANIC_PRIO(15) | CS_WAIT_WRITES;
+}
+
+int dma_busy(int ch) {
+    return (*DMA_CS(ch) & CS_ACTIVE) != 0;
+}
+
+void dma_wait(int ch) {
+    /* Kesme sadece çekirdek 0'a gelir; diğerleri döner */
+    if(smp_core_id() != 0) {
+        while(dma_busy(ch)) {
+            __asm__ volatile("yield");
+        }
+        return;
+    }
+
+    while(dma_busy(ch)) {
+        /* Kontrol ile wfi arasında biten aktarımın kesmesi bekler, kaçmaz */
+        uint64_t flags = irq_save();
+        if(dma_busy(ch)) {
+            __asm__ volatile("wfi");
+        }
+        irq_restore(flags);
+    }
+
+    if(*DMA_CS(ch) & CS_ERROR) {
+        uart_puts("[DMA] Kanal hatasi: ");
+        uart_dec(ch);
+        uart_puts("\n");
+        *DMA_DEBUG(ch) = DEBUG_CLEAR;
+    }
+}
+
+static void dma_reset_channel(int ch) {
+    *DMA_CS(ch) = CS_RESET;
+    for(int i = 0; i < 1000 && (*DMA_CS(ch) & CS_RESET); i++) { }
+    *DMA_CS(ch) = CS_END | CS_INT;
+    *DMA_DEBUG(ch) = DEBUG_CLEAR;
+}
+
+/* 2 satırlık bir kopyada kaç satırın yazıldığına bak (YLENGTH anlamı) */
+static int dma_calibrate(void) {
+    static uint32_t src[8] __attribute__((aligned(64)));
+    static uint32_t dst[16] __attribute__((aligned(64)));
+
+    for(int i = 0; i < 8; i++) src[i] = 0xA5A50000u | i;
+    for(int i = 0; i < 16; i++) dst[i] = 0;
+    dcache_clean_range(src, sizeof(src));
+    dcache_flush_range(dst, sizeof(dst));
+
+    /* YLENGTH = 1 ile 16 baytlık satırlar */
+    ylength_bias = 0;
+    dma_chain_begin(DMA_CH_FILL);
+    if(dma_chain_copy_2d(DMA_CH_FILL, dst, 16, src, 16, 16, 1) < 0) return -1;
+    dma_chain_submit(DMA_CH_FILL);
+
+    for(int i = 0; i < 1000000 && dma_busy(DMA_CH_FILL); i++) { }
+    if(dma_busy(DMA_CH_FILL)) return -1;
+
+    dcache_invalidate_range(dst, sizeof(dst));
+    if(dst[0] != src[0]) return -1;
+
+    /* İkinci satır da yazıldıysa donanım YLENGTH + 1 satır aktarıyor */
+    ylength_bias = (dst[4] == src[4]) ? 1 : 0;
+    return 0;
+}
+
+int dma_init(void) {
+    *DMA_ENABLE |= (1u << DMA_CH_PRESENT) | (1u << DMA_CH_FILL);
+
+    int used[] = { DMA_CH_PRESENT, DMA_CH_FILL };
+    for(int i = 0; i < 2; i++) {
+        int ch = used[i];
+        dma_reset_channel(ch);
+        channels[ch].count = 0;
+        irq_register(IRQ_DMA0 + ch, dma_irq, 0);
+        irq_enable(IRQ_DMA0 + ch);
+    }
+
+    if(dma_calibrate() < 0) {
+        uart_puts("[DMA] Test aktarimi basarisiz, DMA kapali\n");
+        return -1;
+    }
+
+    dma_ready = 1;
+    uart_puts("[DMA] Hazir, 2D satir: YLENGTH");
+    uart_puts(ylength_bias ? "+1\n" : "\n");
+    return 0;
+}
+
+int dma_available(void) {
+    return dma_ready;
+}
@@ -2,6 +2,7 @@
 #include <drivers/input.h>
 #include <drivers/usb_kbd.h>
 #include <hw.h>
+#include <drivers/timer.h>
 
 /* GPIO adresleri */
 #define MMIO_BASE       0x3F000000
@@ -88,87 +89,113 @@ static uint8_t read_gpio_buttons(void) {
     */
 }
 
-/* UART'tan giriş oku (QEMU test için) */
-static uint8_t read_uart_input(void) {
-    uint8_t state = 0;
-    int c = uart_getc();
-
-    if(c < 0) return 0;  /* Karakter yok */
-
-    /* Debug: Gelen karakteri logla */
-    uart_puts("[UART] Karakter: ");
-    char buf[2] = {(char)c, 0};
-    if(c >= 32 && c < 127) {
-        uart_puts(buf);
-    } else {
-        uart_puts("0x");
-        uart_hex(c);
-    }
-    uart_puts("\n");
-
-    /*
-     * Terminal kontrolleri:
-     * w/W veya k/K veya 8 = Yukarı
-     * s/S veya j/J veya 2 = Aşağı
-     * a/A veya h/H veya 4 = Sol
-     * d/D veya l/L veya 6 = Sağ
-     * z/Z veya Enter veya Space = A (Seç)
-     * x/X veya b/B veya Escape = B (Geri)
-     * Ok tuşları: ESC [ A/B/C/D
-     */
-
+/* ESC tek başına mı yoksa ok tuşu dizisinin başı mı? Dizinin geri kalanı
+   bu süre içinde gelmezse ESC = Geri sayılır */
+#define UART_ESC_WAIT_US    30000
+
+/*
+ * Terminal kontrolleri:
+ * w/W veya k/K veya 8 = Yukarı
+ * s/S veya j/J veya 2 = Aşağı
+ * a/A veya h/H veya 4 = Sol
+ * d/D veya l/L veya 6 = Sağ
+ * z/Z veya Enter veya Space = A (Seç)
+ * x/X veya b/B veya Escape = B (Geri)
+ * Ok tuşları: ESC [ A/B/C/D
+ */
+static uint8_t uart_key_to_button(int c) {
     switch(c) {
         /* Yön tuşları - WASD */
         case 'w': case 'W': case 'k': case 'K': case '8':
-            state = BTN_UP;
-            break;
+            return BTN_UP;
         case 's': case 'S': case 'j': case 'J': case '2':
-            state = BTN_DOWN;
-            break;
+            return BTN_DOWN;
         case 'a': case 'A': case 'h': case 'H': case '4':
-            state = BTN_LEFT;
-            break;
+            return BTN_LEFT;
         case 'd': case 'D': case 'l': case 'L': case '6':
-            state = BTN_RIGHT;
-            break;
+            return BTN_RIGHT;
 
         /* Aksiyon tuşları */
         case 'z': case 'Z': case '\r': case '\n': case ' ':
-            state = BTN_A;
-            break;
+            return BTN_A;
         case 'x': case 'X': case 'b': case 'B':
-            state = BTN_B;
-            break;
-
-        /* ESC veya ESC sequence */
-        case 27:  /* Escape */
-            /* Ok tuşları için ESC sequence kontrol et */
-            if(uart_available()) {
-                int c2 = uart_getc();
-                if(c2 == '[' && uart_available()) {
-                    int c3 = uart_getc();
-                    switch(c3) {
-                        case 'A': state = BTN_UP; break;
-                        case 'B': state = BTN_DOWN; break;
-                        case 'C': state = BTN_RIGHT; break;
-                        case 'D': state = BTN_LEFT; break;
-                    }
-                } else {
-                    state = BTN_B;  /* Sadece ESC = Geri */
-                }
-            } else {
-                state = BTN_B;  /* Sadece ESC = Geri */
-            }
-            break;
+            return BTN_B;
 
         /* Start/Select */
         case 'p': case 'P':
-            state = BTN_START;
-            break;
+            return BTN_START;
         case 'o': case 'O':
-            state = BTN_SELECT;
-            break;
+            return BTN_SELECT;
+    }
+    return 0;
+}
+
+/* ESC dizisini çöz; tüketilecek bayt sayısı, 0 = dizi henüz tamamlanmadı */
+static int uart_decode_escape(int index, uint8_t *button) {
+    UartRxEvent esc, next;
+    uint32_t now = (uint32_t)timer_get_ticks();
+
+    uart_rx_peek(index, &esc);
+    *button = BTN_B;  /* Sadece ESC = Geri */
+
+    if(!uart_rx_peek(index + 1, &next)) {
+        return (now - esc.time < UART_ESC_WAIT_US) ? 0 : 1;
+    }
+    if(next.c != '[') return 1;
+
+    if(!uart_rx_peek(index + 2, &next)) {
+        return (now - esc.time < UART_ESC_WAIT_US) ? 0 : 2;
+    }
+    switch(next.c) {
+        case 'A': *button = BTN_UP; break;
+        case 'B': *button = BTN_DOWN; break;
+        case 'C': *button = BTN_RIGHT; break;
+        case 'D': *button = BTN_LEFT; break;
+        default:  *button = 0; break;
+    }
+    return 3;
+}
+
+/* UART'tan giriş oku (QEMU test için) */
+static uint8_t read_uart_input(void) {
+    uint8_t state = 0;
+    int index = 0;
+    UartRxEvent ev;
+
+    /*
+     * Kesme kuyruğunda biriken tuşları sırayla işle. Bu frame'de (veya
+     * bir önceki frame'de) zaten basılı olan butona denk gelen tuş
+     * sonraki frame'e bırakılır: arka arkaya basışların her biri ayrı
+     * bir btn_just_pressed olarak görünür, önden yazılan tuşlar kaybolmaz.
+     */
+    while(uart_rx_peek(index, &ev)) {
+        uint8_t button;
+        int used = 1;
+
+        if(ev.c == 27) {
+            used = uart_decode_escape(index, &button);
+            if(used == 0) break;  /* Dizinin gelmesini bekle */
+        } else {
+            button = uart_key_to_button(ev.c);
+        }
+
+        if(button & (state | uart_input_state)) break;
+
+        /* Debug: Gelen karakteri logla */
+        uart_puts("[UART] Karakter: ");
+        char buf[2] = {(char)ev.c, 0};
+        if(ev.c >= 32 && ev.c < 127) {
+            uart_puts(buf);
+        } else {
+            uart_puts("0x");
+            uart_hex(ev.c);
+        }
+        uart_puts("\n");
+
+        state |= button;
+        index += used;
     }
+    uart_rx_drop(index);
 
     /* Debug: Hangi buton state döndü */
     if(state != 0) {
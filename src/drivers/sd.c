@@ -1,6 +1,8 @@
 /* sd.c - SD Card Driver for Raspberry Pi (EMMC) */
 #include <drivers/sd.h>
 #include <hw.h>
+#include <prof.h>
+#include <trace.h>
 
 /* EMMC Register adresleri (BCM2835/2837) */
 #define MMIO_BASE       0x3F000000
@@ -305,70 +307,55 @@ int sd_init(void) {
 
 /* Tek blok oku */
 int sd_read_block(uint32_t lba, uint8_t *buffer) {
+    PROF_ZONE("sd_read_block");
     if(!sd_card.initialized) return SD_ERROR;
 
-    uart_puts("[SD] read_block lba=");
-    uart_hex(lba);
-    uart_puts(" buf=");
-    uart_hex((uint32_t)(uintptr_t)buffer);
-    uart_puts("\n");
+    TRACE_DBG(TR_SD_READ, lba, (uintptr_t)buffer);
 
     /* Buffer alignment kontrolü */
     if((uintptr_t)buffer & 3) {
-        uart_puts("[SD] WARNING: buffer not 4-byte aligned!\n");
+        TRACE_WARN(TR_SD_UNALIGNED, lba, (uintptr_t)buffer);
     }
 
     /* SDHC için LBA, SDv1/v2 için byte adresi */
     uint32_t addr = (sd_card.type == SD_TYPE_SDHC) ? lba : (lba * 512);
 
-    uart_puts("[SD] addr=");
-    uart_hex(addr);
-    uart_puts("\n");
-
     /* Veri hazır olana kadar bekle */
     if(sd_wait_for_data() != SD_OK) {
-        uart_puts("[SD] wait_for_data TIMEOUT\n");
+        TRACE_ERR(TR_SD_TIMEOUT, lba, 0);
         return SD_TIMEOUT;
     }
 
     /* Blok sayısını ayarla */
     *EMMC_BLKSIZECNT = (1 << 16) | 512;
 
-    uart_puts("[SD] sending CMD17...\n");
-
     /* READ_SINGLE_BLOCK (CMD17) */
     if(sd_send_command(CMD_READ_SINGLE, addr) != SD_OK) {
-        uart_puts("[SD] CMD17 FAILED\n");
+        TRACE_ERR(TR_SD_CMD_FAIL, lba, 17);
         return SD_ERROR;
     }
 
-    uart_puts("[SD] waiting for READ_RDY...\n");
-
     /* Veri okumayı bekle */
     if(sd_wait_for_interrupt(INT_READ_RDY) != SD_OK) {
-        uart_puts("[SD] READ_RDY TIMEOUT\n");
+        TRACE_ERR(TR_SD_TIMEOUT, lba, 1);
         return SD_ERROR;
     }
 
-    uart_puts("[SD] reading data...\n");
-
     /* Veriyi oku */
     uint32_t *buf32 = (uint32_t*)buffer;
     for(int i = 0; i < 128; i++) {
         buf32[i] = *EMMC_DATA;
     }
 
-    uart_puts("[SD] waiting for DATA_DONE...\n");
-
     /* Data done bekle */
     if(sd_wait_for_interrupt(INT_DATA_DONE) != SD_OK) {
-        uart_puts("[SD] DATA_DONE TIMEOUT\n");
+        TRACE_ERR(TR_SD_TIMEOUT, lba, 2);
         return SD_ERROR;
     }
 
     *EMMC_INTERRUPT = INT_DATA_DONE | INT_READ_RDY;
 
-    uart_puts("[SD] read_block OK\n");
+    TRACE_DBG(TR_SD_READ_DONE, lba, 0);
     return SD_OK;
 }
 
@@ -1,5 +1,7 @@
 /* timer.c - System Timer and Clock */
 #include <drivers/timer.h>
+#include <irq.h>
+#include <smp.h>
 
 /* Raspberry Pi System Timer adresleri */
 #define MMIO_BASE       0x3F000000
@@ -8,6 +10,10 @@
 #define TIMER_CS        ((volatile uint32_t*)(TIMER_BASE + 0x00))
 #define TIMER_CLO       ((volatile uint32_t*)(TIMER_BASE + 0x04))
 #define TIMER_CHI       ((volatile uint32_t*)(TIMER_BASE + 0x08))
+#define TIMER_C1        ((volatile uint32_t*)(TIMER_BASE + 0x10))
+
+/* CS register: karşılaştırıcı eşleşme bitleri (1 yazınca temizlenir) */
+#define TIMER_CS_M1     (1 << 1)
 
 /* System Timer 1MHz'de çalışır */
 #define TIMER_FREQ      1000000
@@ -24,11 +30,28 @@ static struct {
     uint32_t tick_accumulator;
 } clock_state;
 
-/* Timer başlat */
+/* Uyku durumu (C1 karşılaştırıcısı, sadece çekirdek 0) */
+static int sleep_ready = 0;
+static uint64_t idle_ticks = 0;
+
+/* C1 eşleşmesi: bayrağı temizle, wfi'dan uyanmak yeterli */
+static void timer_c1_irq(int irq, void *arg) {
+    (void)irq;
+    (void)arg;
+    *TIMER_CS = TIMER_CS_M1;
+}
+
+/* Timer başlat (irq_init'ten sonra çağrılmalı) */
 void timer_init(void) {
     /* System timer otomatik çalışır, başlatma gerekmez */
     clock_state.last_tick = timer_get_ticks();
     clock_state.tick_accumulator = 0;
+
+    /* Frame bekleme için C1 karşılaştırıcı kesmesi */
+    *TIMER_CS = TIMER_CS_M1;
+    irq_register(IRQ_SYSTIMER_1, timer_c1_irq, 0);
+    irq_enable(IRQ_SYSTIMER_1);
+    sleep_ready = 1;
 }
 
 /* 64-bit tick değeri al */
@@ -167,12 +190,45 @@ void clock_format_date(char *buffer) {
     buffer[10] = '\0';
 }
 
-/* Milisaniye bekle */
-void timer_wait_ms(uint32_t ms) {
-    uint64_t target = timer_get_ticks() + (ms * 1000);
+/*
+ * Hedef zamana kadar uyu. C1 karşılaştırıcısı hedefin alt 32 bitine
+ * kurulur, çekirdek wfi ile bekler. IRQ maskeli tutulur ki kontrol ile
+ * wfi arasında gelen kesme kaybolmasın (bekleyen kesme wfi'dan uyandırır),
+ * sonra diğer işleyicilerin de çalışması için kısa süre açılır.
+ */
+void timer_sleep_until(uint64_t target) {
+    if(!sleep_ready || smp_core_id() != 0) {
+        while(timer_get_ticks() < target) {
+            __asm__ volatile("nop");
+        }
+        return;
+    }
+
+    uint64_t flags = irq_save();
+    uint64_t start = timer_get_ticks();
+
+    *TIMER_C1 = (uint32_t)target;
+    __asm__ volatile("dsb sy" : : : "memory");
+
+    /* Yazma tamamlanmadan hedef geçtiyse eşleşme hiç olmaz: kontrol et */
     while(timer_get_ticks() < target) {
-        __asm__ volatile("nop");
+        __asm__ volatile("wfi");
+        irq_enable_cpu();
+        irq_disable_cpu();
     }
+
+    idle_ticks += timer_get_ticks() - start;
+    irq_restore(flags);
+}
+
+/* Uykuda geçen toplam süre (mikrosaniye) */
+uint64_t timer_idle_ticks(void) {
+    return idle_ticks;
+}
+
+/* Milisaniye bekle */
+void timer_wait_ms(uint32_t ms) {
+    timer_sleep_until(timer_get_ticks() + (uint64_t)ms * 1000);
 }
 
 /* Mikrosaniye bekle */
@@ -2533,6 +2533,9 @@ void font_inter_24_medium_draw_char(int x, int y, char c, uint32_t color) {
     const font_inter_24_medium_Glyph* glyph = &font_inter_24_medium_glyphs[idx];
     const uint8_t* pixels = &font_inter_24_medium_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, FONT_INTER_24_MEDIUM_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
@@ -2564,6 +2567,9 @@ void font_inter_24_medium_draw_turkish_char(int x, int y, int tr_index, uint32_t
     const font_inter_24_medium_Glyph* glyph = &font_inter_24_medium_turkish_glyphs[tr_index];
     const uint8_t* pixels = &font_inter_24_medium_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, FONT_INTER_24_MEDIUM_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
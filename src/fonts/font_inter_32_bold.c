@@ -4318,6 +4318,9 @@ void font_inter_32_bold_draw_char(int x, int y, char c, uint32_t color) {
     const font_inter_32_bold_Glyph* glyph = &font_inter_32_bold_glyphs[idx];
     const uint8_t* pixels = &font_inter_32_bold_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, FONT_INTER_32_BOLD_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
@@ -4349,6 +4352,9 @@ void font_inter_32_bold_draw_turkish_char(int x, int y, int tr_index, uint32_t c
     const font_inter_32_bold_Glyph* glyph = &font_inter_32_bold_turkish_glyphs[tr_index];
     const uint8_t* pixels = &font_inter_32_bold_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, FONT_INTER_32_BOLD_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
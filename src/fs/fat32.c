@@ -2,6 +2,8 @@
 #include <fs/fat32.h>
 #include <drivers/sd.h>
 #include <hw.h>
+#include <prof.h>
+#include <trace.h>
 
 /* FAT32 Boot Sector yapısı */
 typedef struct __attribute__((packed)) {
@@ -398,27 +400,11 @@ int fat32_open_dir(const char *path) {
 int fat32_read_dir(FileInfo *info) {
     if(!dir_state.open) return FAT_ERROR;
 
-    static int read_count = 0;
-    read_count++;
-    if(read_count < 5) {
-        uart_puts("[FAT32] read_dir called #");
-        uart_hex(read_count);
-        uart_puts("\n");
-    }
-
     while(1) {
-        uart_puts("[FAT32] loop start\n");
-
         /* Cluster içindeki sektör ve entry hesapla */
         uint32_t entries_per_sector = 512 / sizeof(FAT32DirEntry);
         uint32_t entries_per_cluster = entries_per_sector * fat32.sectors_per_cluster;
 
-        uart_puts("[FAT32] entries_per_sector: ");
-        uart_hex(entries_per_sector);
-        uart_puts(" entry_index: ");
-        uart_hex(dir_state.entry_index);
-        uart_puts("\n");
-
         /* Cluster bitti mi? */
         if(dir_state.entry_index >= entries_per_cluster) {
             /* Sonraki cluster'a geç */
@@ -457,42 +443,28 @@ int fat32_read_dir(FileInfo *info) {
         /* İlk byte'ı güvenli şekilde oku */
         uint8_t first_byte = entry_ptr[0];
 
-        uart_puts("[FAT32] first_byte: ");
-        uart_hex(first_byte);
-        uart_puts("\n");
-
         /* Dizin sonu */
         if(first_byte == 0x00) {
-            uart_puts("[FAT32] EOF reached\n");
             return FAT_EOF;
         }
 
         /* Silinen dosya */
         if(first_byte == 0xE5) {
-            uart_puts("[FAT32] deleted entry, skip\n");
             continue;
         }
 
         /* Attribute byte'ı oku (offset 11) */
         uint8_t attr = entry_ptr[11];
-        uart_puts("[FAT32] attr: ");
-        uart_hex(attr);
-        uart_puts("\n");
+        TRACE_DBG(TR_FAT_DIR_ENTRY, first_byte, attr);
 
         /* Long filename entry - topla */
         if(attr == ATTR_LONG_NAME) {
-            uart_puts("[LFN] entry detected\n");
             uint8_t seq = entry_ptr[0];
             uint8_t chksum = entry_ptr[13];
-            uart_puts("[LFN] seq=");
-            uart_hex(seq);
-            uart_puts(" chk=");
-            uart_hex(chksum);
-            uart_puts("\n");
+            TRACE_DBG(TR_FAT_LFN, seq, chksum);
 
             /* İlk LFN entry (sıra numarası 0x40 ile OR'lanmış) */
             if(seq & 0x40) {
-                uart_puts("[LFN] first entry\n");
                 /* Yeni LFN başlıyor */
                 dir_state.lfn_index = 0;
                 dir_state.lfn_checksum = chksum;
@@ -507,33 +479,19 @@ int fat32_read_dir(FileInfo *info) {
             }
 
             if(dir_state.lfn_valid) {
-                uart_puts("[LFN] extracting chars\n");
                 /* LFN entry'ler ters sırada gelir */
                 int seq_num = (seq & 0x1F) - 1;  /* 0-indexed sıra */
                 int buf_offset = seq_num * 13;
-                uart_puts("[LFN] seq_num=");
-                uart_hex(seq_num);
-                uart_puts(" buf_offset=");
-                uart_hex(buf_offset);
-                uart_puts("\n");
 
                 /* Her LFN entry 13 karakter içerir */
                 for(int i = 0; i < 13; i++) {
-                    uart_puts("[LFN] reading char ");
-                    uart_hex(i);
-                    uart_puts("\n");
                     char c = lfn_read_char(entry_ptr, i);
-                    uart_puts("[LFN] got: ");
-                    uart_hex(c);
-                    uart_puts("\n");
                     if(c == 0) break;
                     if(buf_offset + i < 255) {
                         dir_state.lfn_buffer[buf_offset + i] = c;
                     }
                 }
-                uart_puts("[LFN] chars done\n");
             }
-            uart_puts("[LFN] continue\n");
             continue;
         }
 
@@ -605,10 +563,6 @@ int fat32_close_dir(void) {
 int fat32_open(const char *path, uint8_t mode) {
     if(!fat32.mounted) return -1;
 
-    uart_puts("[FAT32] open: ");
-    uart_puts((char*)path);
-    uart_puts("\n");
-
     /* Boş slot bul */
     int fd = -1;
     for(int i = 0; i < MAX_OPEN_FILES; i++) {
@@ -651,15 +605,9 @@ int fat32_open(const char *path, uint8_t mode) {
         filename = p;
     }
 
-    uart_puts("[FAT32] dir: ");
-    uart_puts(dir_path);
-    uart_puts(" file: ");
-    uart_puts((char*)filename);
-    uart_puts("\n");
-
     /* Dizini aç */
     if(fat32_open_dir(dir_path) != FAT_OK) {
-        uart_puts("[FAT32] open_dir failed\n");
+        TRACE_WARN(TR_FAT_OPEN_FAIL, 1, 0);
         return -1;
     }
 
@@ -679,27 +627,17 @@ int fat32_open(const char *path, uint8_t mode) {
         }
         if(match && !filename[i] && !info.name[i] && !info.is_dir) {
             found = 1;
-            uart_puts("[FAT32] Found file: ");
-            uart_puts(info.name);
-            uart_puts(" cluster=");
-            uart_hex(info.cluster);
-            uart_puts(" size=");
-            uart_hex(info.size);
-            uart_puts("\n");
             break;
         }
     }
 
-    uart_puts("[FAT32] closing dir\n");
     fat32_close_dir();
 
     if(!found) {
-        uart_puts("[FAT32] file not found\n");
+        TRACE_WARN(TR_FAT_OPEN_FAIL, 2, 0);
         return -1;
     }
 
-    uart_puts("[FAT32] setting up file handle\n");
-
     /* Dosyayı aç */
     open_files[fd].used = 1;
     open_files[fd].start_cluster = info.cluster;
@@ -708,20 +646,15 @@ int fat32_open(const char *path, uint8_t mode) {
     open_files[fd].size = info.size;
     open_files[fd].mode = mode;
 
-    uart_puts("[FAT32] open complete, fd=");
-    uart_hex(fd);
-    uart_puts("\n");
+    TRACE_INFO(TR_FAT_OPEN, info.cluster, info.size);
 
     return fd;
 }
 
 /* Dosyadan oku */
 int fat32_read(int fd, void *buffer, uint32_t size) {
-    uart_puts("[READ] fd=");
-    uart_hex(fd);
-    uart_puts(" size=");
-    uart_hex(size);
-    uart_puts("\n");
+    PROF_ZONE("fat32_read");
+    TRACE_DBG(TR_FAT_READ, fd, size);
 
     if(fd < 0 || fd >= MAX_OPEN_FILES) return -1;
     if(!open_files[fd].used) return -1;
@@ -730,12 +663,6 @@ int fat32_read(int fd, void *buffer, uint32_t size) {
     uint8_t *buf = (uint8_t*)buffer;
     uint32_t bytes_read = 0;
 
-    uart_puts("[READ] cluster=");
-    uart_hex(f->cluster);
-    uart_puts(" pos=");
-    uart_hex(f->position);
-    uart_puts("\n");
-
     while(bytes_read < size && f->position < f->size) {
         /* Cluster içindeki pozisyon */
         uint32_t cluster_offset = f->position % fat32.cluster_size;
@@ -744,12 +671,10 @@ int fat32_read(int fd, void *buffer, uint32_t size) {
 
         /* Sektörü oku - statik buffer kullan */
         uint32_t sector = cluster_to_sector(f->cluster) + sector_offset;
-        uart_puts("[READ] sector=");
-        uart_hex(sector);
-        uart_puts("\n");
+        TRACE_DBG(TR_FAT_SECTOR, sector, f->position);
 
         if(sd_read_block(sector, file_sector_buffer) != SD_OK) {
-            uart_puts("[READ] sd_read_block FAILED\n");
+            TRACE_ERR(TR_FAT_READ_FAIL, sector, fd);
             return bytes_read > 0 ? bytes_read : -1;
         }
 
@@ -775,9 +700,7 @@ int fat32_read(int fd, void *buffer, uint32_t size) {
         }
     }
 
-    uart_puts("[READ] returning bytes_read=");
-    uart_hex(bytes_read);
-    uart_puts("\n");
+    TRACE_DBG(TR_FAT_READ_DONE, fd, bytes_read);
     return bytes_read;
 }
 
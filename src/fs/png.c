@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 #include <hw.h>
+#include <task.h>
+#include <mm.h>
+#include <prof.h>
+#include <trace.h>
 
 /* PNG Signature */
 static const uint8_t PNG_SIG[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
@@ -161,8 +165,6 @@ static uint8_t fixed_lens[288];
 static void init_fixed_tables(void) {
     if(tables_initialized) return;
 
-    uart_puts("[INFLATE] building fixed lit table\n");
-
     int i;
     /* Fixed literal/length table */
     for(i = 0; i < 144; i++) fixed_lens[i] = 8;
@@ -171,14 +173,11 @@ static void init_fixed_tables(void) {
     for(i = 280; i < 288; i++) fixed_lens[i] = 8;
     build_huffman(&fixed_lit_table, fixed_lens, 288);
 
-    uart_puts("[INFLATE] building fixed dist table\n");
-
     /* Fixed distance table */
     for(i = 0; i < 32; i++) fixed_lens[i] = 5;
     build_huffman(&fixed_dist_table, fixed_lens, 32);
 
     tables_initialized = 1;
-    uart_puts("[INFLATE] fixed tables ready\n");
 }
 
 /* Decode dynamic Huffman tables */
@@ -273,15 +272,7 @@ static int decode_block(DeflateState *s, HuffmanTable *lit_tbl, HuffmanTable *di
 
 /* Main deflate decompression */
 static int inflate(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t dst_len) {
-    uart_puts("[INFLATE] src_len=");
-    uart_hex(src_len);
-    uart_puts(" dst_len=");
-    uart_hex(dst_len);
-    uart_puts("\n");
-
-    uart_puts("[INFLATE] init tables\n");
     init_fixed_tables();
-    uart_puts("[INFLATE] tables done\n");
 
     DeflateState state = {
         .src = src,
@@ -299,11 +290,7 @@ static int inflate(const uint8_t *src, uint32_t src_len, uint8_t *dst, uint32_t
         bfinal = read_bits(&state, 1);
         int btype = read_bits(&state, 2);
 
-        uart_puts("[INFLATE] bfinal=");
-        uart_hex(bfinal);
-        uart_puts(" btype=");
-        uart_hex(btype);
-        uart_puts("\n");
+        TRACE_DBG(TR_PNG_INFLATE_BLOCK, bfinal, btype);
 
         if(btype == 0) {
             /* Stored block */
@@ -423,21 +410,61 @@ static void unfilter_row(volatile uint8_t *row, volatile const uint8_t *prev, in
     }
 }
 
-/* PNG decode buffers - static to avoid stack overflow */
-#define PNG_MAX_WIDTH 640
-#define PNG_MAX_HEIGHT 480
-#define PNG_MAX_IDAT (256 * 1024)  /* 256KB for compressed data */
-#define PNG_MAX_RAW  (PNG_MAX_WIDTH * PNG_MAX_HEIGHT * 4 + PNG_MAX_HEIGHT)  /* RGBA + filter bytes */
-
-static uint8_t png_idat_buf[PNG_MAX_IDAT];
-static uint8_t png_raw_buf[PNG_MAX_RAW];
-static uint8_t png_prev_row[PNG_MAX_WIDTH * 4];
+/* PNG decode buffers - decode süresince arena'dan ödünç alınır */
+static Arena png_arena;
+static uint8_t *png_idat_buf;   /* Birleştirilmiş IDAT (en fazla dosya boyutu) */
+static uint32_t png_idat_cap;
+static uint8_t *png_raw_buf;    /* Açılmış satırlar + filtre baytları */
+static uint32_t png_raw_cap;
+static uint8_t *png_prev_row;   /* İlk satır için sıfır "üst" satır */
 static uint8_t png_palette[256 * 3];  /* Max 256 colors, RGB */
 
-/* PNG decode function */
-int png_decode(const uint8_t *data, uint32_t data_len,
-               uint8_t *pixels, int max_width, int max_height,
-               int *out_width, int *out_height) {
+/* Çözülmüş satırları framebuffer formatına (BGRA) dönüştürme işi */
+typedef struct {
+    const uint8_t *raw;
+    uint8_t *pixels;
+    uint32_t stride;        /* Çıkış satır genişliği (piksel) */
+    uint32_t width;
+    int bpp;
+    int row_bytes;
+    int color_type;
+} PngConvertJob;
+
+static void png_convert_rows(int y0, int y1, void *arg) {
+    PngConvertJob *job = (PngConvertJob *)arg;
+
+    for(int y = y0; y < y1; y++) {
+        volatile const uint8_t *row = job->raw + (uint32_t)y * (job->row_bytes + 1) + 1;
+
+        /* Convert to output format (RGBA) */
+        volatile uint8_t *out = job->pixels;
+        for(uint32_t x = 0; x < job->width; x++) {
+            uint32_t dst_idx = ((uint32_t)y * job->stride + x) * 4;
+
+            if(job->color_type == PNG_COLOR_INDEXED) {
+                /* Indexed color - lookup in palette */
+                /* PNG: RGB, Framebuffer: BGR */
+                uint8_t idx = row[x];
+                out[dst_idx + 0] = png_palette[idx * 3 + 2];  /* B */
+                out[dst_idx + 1] = png_palette[idx * 3 + 1];  /* G */
+                out[dst_idx + 2] = png_palette[idx * 3 + 0];  /* R */
+                out[dst_idx + 3] = 255;  /* A */
+            } else {
+                /* PNG: RGB(A), Framebuffer: BGR(A) */
+                uint32_t src_idx = x * job->bpp;
+                out[dst_idx + 0] = row[src_idx + 2];  /* B */
+                out[dst_idx + 1] = row[src_idx + 1];  /* G */
+                out[dst_idx + 2] = row[src_idx + 0];  /* R */
+                out[dst_idx + 3] = (job->bpp == 4) ? row[src_idx + 3] : 255;  /* A */
+            }
+        }
+    }
+}
+
+/* PNG decode (tamponlar png_decode tarafından hazırlanır) */
+static int png_decode_image(const uint8_t *data, uint32_t data_len,
+                            uint8_t *pixels, int max_width, int max_height,
+                            int *out_width, int *out_height) {
 
     init_crc32();
 
@@ -455,19 +482,7 @@ int png_decode(const uint8_t *data, uint32_t data_len,
     int palette_size = 0;
 
     /* Parse chunks */
-    uart_puts("[PNG] Parsing chunks... data=");
-    uart_hex((uint32_t)(uintptr_t)data);
-    uart_puts(" len=");
-    uart_hex(data_len);
-    uart_puts("\n");
-
     while(pos + 12 <= data_len) {
-        uart_puts("[PNG] loop: pos=");
-        uart_hex(pos);
-        uart_puts(" reading at ");
-        uart_hex((uint32_t)(uintptr_t)(data + pos));
-        uart_puts("\n");
-
         volatile uint8_t b0 = data[pos];
         volatile uint8_t b1 = data[pos + 1];
         volatile uint8_t b2 = data[pos + 2];
@@ -480,13 +495,7 @@ int png_decode(const uint8_t *data, uint32_t data_len,
         volatile uint8_t t3 = data[pos + 7];
         uint32_t chunk_type = ((uint32_t)t0 << 24) | ((uint32_t)t1 << 16) | ((uint32_t)t2 << 8) | (uint32_t)t3;
 
-        uart_puts("[PNG] chunk pos=");
-        uart_hex(pos);
-        uart_puts(" type=");
-        uart_hex(chunk_type);
-        uart_puts(" len=");
-        uart_hex(chunk_len);
-        uart_puts("\n");
+        TRACE_DBG(TR_PNG_CHUNK, chunk_type, chunk_len);
 
         if(pos + 12 + chunk_len > data_len) {
             uart_puts("[PNG] chunk overflow, breaking\n");
@@ -504,15 +513,8 @@ int png_decode(const uint8_t *data, uint32_t data_len,
             bit_depth = chunk_data[8];
             color_type = chunk_data[9];
 
-            uart_puts("[PNG] W=");
-            uart_hex(width);
-            uart_puts(" H=");
-            uart_hex(height);
-            uart_puts(" depth=");
-            uart_hex(bit_depth);
-            uart_puts(" color=");
-            uart_hex(color_type);
-            uart_puts("\n");
+            TRACE_INFO(TR_PNG_HEADER, width, height);
+            TRACE_INFO(TR_PNG_FORMAT, bit_depth, color_type);
 
             /* Only support 8-bit RGB, RGBA, and indexed */
             if(bit_depth != 8) {
@@ -536,32 +538,19 @@ int png_decode(const uint8_t *data, uint32_t data_len,
             } else {
                 bpp = 1;  /* Indexed = 1 byte per pixel */
             }
-            uart_puts("[PNG] bpp=");
-            uart_hex(bpp);
-            uart_puts(" IHDR done\n");
 
         } else if(chunk_type == CHUNK_PLTE) {
             /* Palette chunk */
-            uart_puts("[PNG] PLTE chunk len=");
-            uart_hex(chunk_len);
-            uart_puts("\n");
             palette_size = chunk_len / 3;
             if(palette_size > 256) palette_size = 256;
-            uart_puts("[PNG] reading palette...\n");
             volatile const uint8_t *pal_src = chunk_data;
             for(int i = 0; i < palette_size * 3; i++) {
                 png_palette[i] = pal_src[i];
             }
-            uart_puts("[PNG] palette_size=");
-            uart_hex(palette_size);
-            uart_puts("\n");
 
         } else if(chunk_type == CHUNK_IDAT) {
             /* Image data - collect all IDAT chunks */
-            uart_puts("[PNG] IDAT chunk len=");
-            uart_hex(chunk_len);
-            uart_puts("\n");
-            if(idat_len + chunk_len > PNG_MAX_IDAT) {
+            if(idat_len + chunk_len > png_idat_cap) {
                 uart_puts("[PNG] IDAT too large\n");
                 return -1;
             }
@@ -571,19 +560,13 @@ int png_decode(const uint8_t *data, uint32_t data_len,
 
         } else if(chunk_type == CHUNK_IEND) {
             /* End of image */
-            uart_puts("[PNG] IEND found\n");
             break;
         }
 
         pos += 12 + chunk_len;
-        uart_puts("[PNG] next pos=");
-        uart_hex(pos);
-        uart_puts("\n");
     }
 
-    uart_puts("[PNG] Loop done. Total IDAT: ");
-    uart_hex(idat_len);
-    uart_puts("\n");
+    TRACE_DBG(TR_PNG_IDAT, idat_len, 0);
 
     if(width == 0 || height == 0 || idat_len == 0) {
         uart_puts("[PNG] Invalid PNG\n");
@@ -612,10 +595,8 @@ int png_decode(const uint8_t *data, uint32_t data_len,
     }
 
     /* Decompress */
-    uart_puts("[PNG] Decompressing...\n");
-
     uint32_t raw_size = (width * bpp + 1) * height;  /* +1 for filter byte per row */
-    if(raw_size > PNG_MAX_RAW) {
+    if(raw_size > png_raw_cap) {
         uart_puts("[PNG] Image too large for buffer\n");
         return -1;
     }
@@ -626,51 +607,28 @@ int png_decode(const uint8_t *data, uint32_t data_len,
         return -1;
     }
 
-    uart_puts("[PNG] Decompressed ");
-    uart_hex(decompressed);
-    uart_puts(" bytes\n");
+    TRACE_INFO(TR_PNG_INFLATE, idat_len, decompressed);
 
     /* Unfilter and convert to RGBA */
-    uart_puts("[PNG] Unfiltering...\n");
-
     int row_bytes = (int)(width * bpp);
-    uart_puts("[PNG] row_bytes=");
-    uart_hex(row_bytes);
-    uart_puts("\n");
 
     uint32_t raw_pos = 0;
 
-    uart_puts("[PNG] Clearing prev_row\n");
-    /* Clear previous row */
+    /* Clear previous row (ilk satırın "üst" satırı sıfırdır) */
     for(int i = 0; i < row_bytes; i++) {
         png_prev_row[i] = 0;
     }
-    uart_puts("[PNG] prev_row cleared\n");
-
-    uart_puts("[PNG] Starting row loop, height=");
-    uart_hex(height);
-    uart_puts("\n");
 
+    /* 1. geçiş: filtreleri sırayla çöz (her satır bir öncekine bağlı) */
+    volatile const uint8_t *prev = png_prev_row;
     for(uint32_t y = 0; y < height; y++) {
-        /* Progress her 20 satırda bir */
-        if(y % 20 == 0) {
-            uart_puts("[PNG] row ");
-            uart_hex(y);
-            uart_puts("\n");
-        }
-
         /* Get filter type */
         uint8_t filter = png_raw_buf[raw_pos++];
+        TRACE_DBG(TR_PNG_ROW, y, filter);
 
         /* Debug: filter type kontrol */
         if(filter > 4) {
-            uart_puts("[PNG] BAD filter=");
-            uart_hex(filter);
-            uart_puts(" at y=");
-            uart_hex(y);
-            uart_puts(" raw_pos=");
-            uart_hex(raw_pos - 1);
-            uart_puts("\n");
+            TRACE_ERR(TR_PNG_BAD_FILTER, filter, y);
             return -1;
         }
 
@@ -678,43 +636,55 @@ int png_decode(const uint8_t *data, uint32_t data_len,
         volatile uint8_t *row = png_raw_buf + raw_pos;
         raw_pos += row_bytes;
 
-        /* Unfilter */
-        unfilter_row(row, png_prev_row, filter, bpp, row_bytes);
-
-        /* Copy to previous row for next iteration */
-        for(int i = 0; i < row_bytes; i++) {
-            png_prev_row[i] = row[i];
-        }
-
-        /* Convert to output format (RGBA) */
-        volatile uint8_t *out = pixels;
-        for(uint32_t x = 0; x < width; x++) {
-            uint32_t dst_idx = (y * (uint32_t)max_width + x) * 4;
-
-            if(color_type == PNG_COLOR_INDEXED) {
-                /* Indexed color - lookup in palette */
-                /* PNG: RGB, Framebuffer: BGR */
-                uint8_t idx = row[x];
-                out[dst_idx + 0] = png_palette[idx * 3 + 2];  /* B */
-                out[dst_idx + 1] = png_palette[idx * 3 + 1];  /* G */
-                out[dst_idx + 2] = png_palette[idx * 3 + 0];  /* R */
-                out[dst_idx + 3] = 255;  /* A */
-            } else {
-                /* PNG: RGB(A), Framebuffer: BGR(A) */
-                uint32_t src_idx = x * bpp;
-                out[dst_idx + 0] = row[src_idx + 2];  /* B */
-                out[dst_idx + 1] = row[src_idx + 1];  /* G */
-                out[dst_idx + 2] = row[src_idx + 0];  /* R */
-                out[dst_idx + 3] = (bpp == 4) ? row[src_idx + 3] : 255;  /* A */
-            }
-        }
+        /* Unfilter (önceki satır zaten çözülmüş halde raw buffer'da) */
+        unfilter_row(row, prev, filter, bpp, row_bytes);
+        prev = row;
     }
 
-    uart_puts("[PNG] All rows done\n");
+    /* 2. geçiş: satırlar bağımsız, çekirdeklere dağıtarak dönüştür */
+    PngConvertJob job;
+    job.raw = png_raw_buf;
+    job.pixels = pixels;
+    job.stride = (uint32_t)max_width;
+    job.width = width;
+    job.bpp = bpp;
+    job.row_bytes = row_bytes;
+    job.color_type = color_type;
+    parallel_for(0, (int)height, 16, png_convert_rows, &job);
 
     *out_width = width;
     *out_height = height;
 
-    uart_puts("[PNG] Decode complete\n");
     return 0;
 }
+
+/* PNG decode function */
+int png_decode(const uint8_t *data, uint32_t data_len,
+               uint8_t *pixels, int max_width, int max_height,
+               int *out_width, int *out_height) {
+    PROF_ZONE("png_decode");
+    uint32_t row_cap = (uint32_t)max_width * 4;
+    uint32_t raw_cap = (row_cap + 1) * (uint32_t)max_height;
+
+    if(max_width <= 0 || max_height <= 0) return -1;
+
+    /* Geçici bellek: IDAT + raw + sıfır satır (hizalama payıyla) */
+    if(arena_init(&png_arena, data_len + raw_cap + row_cap + 3 * 64) < 0) {
+        uart_puts("[PNG] Out of memory\n");
+        return -1;
+    }
+    png_idat_cap = data_len;
+    png_idat_buf = (uint8_t *)arena_alloc(&png_arena, png_idat_cap, 64);
+    png_raw_cap = raw_cap;
+    png_raw_buf = (uint8_t *)arena_alloc(&png_arena, png_raw_cap, 64);
+    png_prev_row = (uint8_t *)arena_alloc(&png_arena, row_cap, 64);
+
+    int result = png_decode_image(data, data_len, pixels, max_width, max_height,
+                                  out_width, out_height);
+
+    arena_destroy(&png_arena);
+    png_idat_buf = 0;
+    png_raw_buf = 0;
+    png_prev_row = 0;
+    return result;
+}
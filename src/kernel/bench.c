@@ -0,0 +1,331 @@
+/* bench.c - Çekirdek içi mikro ölçümler (make BENCH=1) */
+#include <bench.h>
+#include <hw.h>
+#include <smp.h>
+#include <task.h>
+#include <blend.h>
+#include <graphics.h>
+#include <displist.h>
+#include <logo.h>
+#include <fonts/fonts.h>
+
+#ifdef CONFIG_BENCH
+
+#define BENCH_SPAWN_COUNT   10000
+#define BENCH_PFOR_COUNT    1000
+
+/* Ondalık sayı yaz (uart_hex yanında okunabilir sonuç için) */
+static void bench_put_dec(uint64_t v) {
+    char buf[21];
+    int i = 20;
+    buf[i] = '\0';
+    do {
+        buf[--i] = '0' + (v % 10);
+        v /= 10;
+    } while(v && i > 0);
+    uart_puts(&buf[i]);
+}
+
+/* ticks -> nanosaniye */
+static uint64_t ticks_to_ns(uint64_t ticks) {
+    return ticks * 1000000000ULL / bench_freq();
+}
+
+/* "[BENCH] ad: X ns/op" satırı */
+static void bench_report(const char *name, uint64_t ticks, uint32_t ops) {
+    uart_puts("[BENCH] ");
+    uart_puts((char *)name);
+    uart_puts(": ");
+    bench_put_dec(ticks_to_ns(ticks) / (ops ? ops : 1));
+    uart_puts(" ns/op (");
+    bench_put_dec(ops);
+    uart_puts(" op)\n");
+}
+
+static void empty_task(void *arg) {
+    (void)arg;
+}
+
+static void empty_range(int begin, int end, void *arg) {
+    (void)begin;
+    (void)end;
+    (void)arg;
+}
+
+/* Çalınma oranını ölçmek için biraz iş yapan görev */
+static void busy_task(void *arg) {
+    volatile uint32_t *sink = (volatile uint32_t *)arg;
+    for(int i = 0; i < 2000; i++) {
+        *sink += i;
+    }
+}
+
+static void bench_task(void) {
+    uint64_t t0, t1;
+    volatile uint32_t sink = 0;
+
+    uart_puts("[BENCH] Gorev sistemi, cekirdek sayisi: ");
+    bench_put_dec(smp_num_cores());
+    uart_puts("\n");
+
+    /* Spawn + wait, boş görev (kuyruk ekleme/alma maliyeti) */
+    task_stat_reset();
+    t0 = bench_ticks();
+    for(int i = 0; i < BENCH_SPAWN_COUNT; i++) {
+        task_spawn(empty_task, 0);
+        if((i & 63) == 63) task_group_wait();
+    }
+    task_group_wait();
+    t1 = bench_ticks();
+    bench_report("task_spawn+wait (bos)", t1 - t0, BENCH_SPAWN_COUNT);
+
+    /* parallel_for, boş gövde: bölme + dağıtma + bekleme */
+    t0 = bench_ticks();
+    for(int i = 0; i < BENCH_PFOR_COUNT; i++) {
+        parallel_for(0, 480, 32, empty_range, 0);
+    }
+    t1 = bench_ticks();
+    bench_report("parallel_for 480/32 (bos)", t1 - t0, BENCH_PFOR_COUNT);
+
+    /* Çalma: çekirdek 0 üretir, diğerleri çalar */
+    task_stat_reset();
+    t0 = bench_ticks();
+    for(int i = 0; i < 1024; i++) {
+        task_spawn(busy_task, (void *)&sink);
+        if((i & 127) == 127) task_group_wait();
+    }
+    task_group_wait();
+    t1 = bench_ticks();
+    bench_report("task busy (2000 iter)", t1 - t0, 1024);
+
+    for(int core = 0; core < SMP_MAX_CORES; core++) {
+        uart_puts("[BENCH]   cekirdek ");
+        bench_put_dec(core);
+        uart_puts(": calistirilan ");
+        bench_put_dec(task_stat_executed(core));
+        uart_puts(", calinan ");
+        bench_put_dec(task_stat_stolen(core));
+        uart_puts("\n");
+    }
+}
+
+/* libk bellek fonksiyonları: 64 B, 4 KB ve tam ekran (1.2 MB) */
+#define BENCH_BIG_SIZE  (640 * 480 * 4)
+
+static uint8_t bench_src[BENCH_BIG_SIZE] __attribute__((aligned(64)));
+static uint8_t bench_dst[BENCH_BIG_SIZE] __attribute__((aligned(64)));
+
+/* "[BENCH] ad N B: X.YY bayt/cycle" */
+static void bench_report_bpc(const char *name, uint32_t size, uint64_t bytes, uint64_t cycles) {
+    uint64_t bpc100 = cycles ? bytes * 100 / cycles : 0;
+
+    uart_puts("[BENCH] ");
+    uart_puts((char *)name);
+    uart_puts(" ");
+    bench_put_dec(size);
+    uart_puts(" B: ");
+    bench_put_dec(bpc100 / 100);
+    uart_puts(".");
+    if(bpc100 % 100 < 10) uart_puts("0");
+    bench_put_dec(bpc100 % 100);
+    uart_puts(" bayt/cycle\n");
+}
+
+static void bench_libk(void) {
+    static const uint32_t sizes[3] = { 64, 4096, BENCH_BIG_SIZE };
+    static const uint32_t iters[3] = { 100000, 2000, 10 };
+    volatile int sink = 0;
+    uint64_t c0, c1;
+
+    bench_cycles_init();
+
+    for(int i = 0; i < 3; i++) {
+        uint32_t size = sizes[i];
+        uint64_t bytes = (uint64_t)size * iters[i];
+
+        c0 = bench_cycles();
+        for(uint32_t n = 0; n < iters[i]; n++) {
+            memcpy(bench_dst, bench_src, size);
+        }
+        c1 = bench_cycles();
+        bench_report_bpc("memcpy", size, bytes, c1 - c0);
+
+        c0 = bench_cycles();
+        for(uint32_t n = 0; n < iters[i]; n++) {
+            memset(bench_dst, (int)n, size);
+        }
+        c1 = bench_cycles();
+        bench_report_bpc("memset", size, bytes, c1 - c0);
+
+        /* Hizasız ve örtüşen kopya */
+        c0 = bench_cycles();
+        for(uint32_t n = 0; n < iters[i]; n++) {
+            memmove(bench_dst + 1, bench_dst, size - 1);
+        }
+        c1 = bench_cycles();
+        /* Örtüşme için bir bayt kısa: raporda taşınan bayt sayısı */
+        bench_report_bpc("memmove", size - 1, (uint64_t)(size - 1) * iters[i], c1 - c0);
+
+        c0 = bench_cycles();
+        for(uint32_t n = 0; n < iters[i]; n++) {
+            memcpy(bench_dst, bench_src, size);
+            sink += memcmp(bench_dst, bench_src, size);
+        }
+        c1 = bench_cycles();
+        bench_report_bpc("memcpy+memcmp", size, bytes, c1 - c0);
+    }
+}
+
+/* Eski piksel başına /255 karıştırma (karşılaştırma için) */
+static void blend_span_div(uint32_t *dst, int n, uint32_t color, uint8_t alpha) {
+    uint8_t inv = 255 - alpha;
+    for(int i = 0; i < n; i++) {
+        uint32_t bg = dst[i];
+        uint8_t r = (((color >> 16) & 0xFF) * alpha + ((bg >> 16) & 0xFF) * inv) / 255;
+        uint8_t g = (((color >> 8) & 0xFF) * alpha + ((bg >> 8) & 0xFF) * inv) / 255;
+        uint8_t b = ((color & 0xFF) * alpha + (bg & 0xFF) * inv) / 255;
+        dst[i] = 0xFF000000 | (r << 16) | (g << 8) | b;
+    }
+}
+
+/* Tam ekran alpha karıştırma: blend_span, blend_span_glass, eski döngü ve blit/blur çekirdekleri */
+static void bench_blend(void) {
+    uint32_t *px = (uint32_t *)bench_dst;
+    int n = BENCH_BIG_SIZE / 4;
+    uint64_t c0, c1;
+
+    bench_cycles_init();
+
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blend_span(px, n, 0xFF3366CC, (uint8_t)(40 + i));
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blend_span", BENCH_BIG_SIZE, (uint64_t)BENCH_BIG_SIZE * 10, c1 - c0);
+
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blend_span_glass(px, n, 0xFFFFFFFF, (uint8_t)(40 + i));
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blend_span_glass", BENCH_BIG_SIZE, (uint64_t)BENCH_BIG_SIZE * 10, c1 - c0);
+
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blend_span_div(px, n, 0xFF3366CC, (uint8_t)(40 + i));
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blend /255 (eski)", BENCH_BIG_SIZE, (uint64_t)BENCH_BIG_SIZE * 10, c1 - c0);
+
+    /* Blit satırları: bench_src kaynak (önçarpımlı sayılır) */
+    const uint32_t *src = (const uint32_t *)bench_src;
+
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blend_span_over(px, src, n);
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blend_span_over", BENCH_BIG_SIZE, (uint64_t)BENCH_BIG_SIZE * 10, c1 - c0);
+
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blend_span_key(px, src, n, 0);
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blend_span_key", BENCH_BIG_SIZE, (uint64_t)BENCH_BIG_SIZE * 10, c1 - c0);
+
+    /* Cam bulanıklığı dikey geçişi, çeyrek çözünürlük tam ekran (160x120) */
+    c0 = bench_cycles();
+    for(int i = 0; i < 10; i++) {
+        blur_box_cols(px, src, 160, 120, 2);
+    }
+    c1 = bench_cycles();
+    bench_report_bpc("blur_box_cols", 160 * 120 * 4, (uint64_t)160 * 120 * 4 * 10, c1 - c0);
+}
+
+/*
+ * Frame süresi: tipik bir menü sahnesi displist üzerinden çizilip sunulur.
+ * "tam" her frame tüm ekranı yeniden çizer, "kismi" sadece kayan paneli.
+ * 32 ve 16 bpp'yi karşılaştırmak için iki derleme (FB16=1) aynı satırları
+ * basar: make BENCH=1 qemu / make BENCH=1 FB16=1 qemu.
+ */
+#define BENCH_FRAMES    60
+
+static int bench_frame_no;
+
+static void bench_scene(void) {
+    int x = 80 + (bench_frame_no % 30) * 4;
+
+    draw_gradient_bg(0xFF101828, 0xFF283850);
+    draw_rect(0, 0, SCREEN_WIDTH, 50, 0xFF151515);
+    draw_text_20_bold(20, 15, "EmConOs", 0xFFFFFFFF);
+    draw_logo(480, 120, 4);
+    draw_shadow(x, 140, 220, 160, 8, 120);
+    draw_rounded_rect_alpha(x, 140, 220, 160, 12, 0xFF3366CC, 200);
+    draw_text_16(x + 20, 160, "Oyunlar", 0xFFFFFFFF);
+    draw_glass_panel(40, 340, 560, 100, 0xFFFFFFFF, 60);
+    draw_text_16(60, 380, "Dosya Yoneticisi  Ayarlar  Hakkinda", 0xFFDDDDDD);
+}
+
+static void bench_frame_run(const char *name, int full) {
+    uint64_t bytes = 0;
+    uint64_t t0, t1;
+
+    t0 = bench_ticks();
+    for(bench_frame_no = 0; bench_frame_no < BENCH_FRAMES; bench_frame_no++) {
+        if(full) {
+            displist_invalidate();
+            graphics_invalidate();
+        }
+        if(displist_render(bench_scene)) {
+            graphics_swap_buffers();
+            bytes += graphics_presented_bytes();
+        }
+    }
+    t1 = bench_ticks();
+
+    uart_puts("[BENCH] frame ");
+    uart_puts((char *)name);
+    uart_puts(" ");
+    bench_put_dec(FB_BPP);
+    uart_puts("bpp: ");
+    bench_put_dec(ticks_to_ns(t1 - t0) / BENCH_FRAMES);
+    uart_puts(" ns/frame, sunum ");
+    bench_put_dec(bytes / BENCH_FRAMES);
+    uart_puts(" B/frame, yazim/piksel x100 ");
+    bench_put_dec(displist_overdraw());
+    uart_puts("\n");
+}
+
+static void bench_frame(void) {
+    if(!draw_buffer) return;
+
+    bench_frame_run("tam", 1);
+    bench_frame_run("kismi", 0);
+
+    /* Aynı sahne 320x240'ta (sağ/alt kısım kırpılır), GPU büyütür */
+    if(graphics_set_scale(2) == 0) {
+        bench_frame_run("tam/2", 1);
+        graphics_set_scale(1);
+    }
+
+    /* Sonraki gerçek frame tüm ekranı çizsin */
+    displist_invalidate();
+    graphics_invalidate();
+}
+
+void bench_run_all(void) {
+    uart_puts("\n[BENCH] Olcumler basliyor\n");
+    bench_libk();
+    bench_blend();
+    bench_frame();
+    bench_task();
+    uart_puts("[BENCH] Bitti\n\n");
+}
+
+#else
+
+void bench_run_all(void) {
+}
+
+#endif
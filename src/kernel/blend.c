@@ -0,0 +1,173 @@
+/* blend.c - Skaler alpha karıştırma span'leri (BLEND_SCALAR=1), RGB565 (FB16=1) ve paletli (FB8=1) span'ler */
+#include <blend.h>
+
+#ifdef CONFIG_BLEND_SCALAR
+
+/* NEON sürümü src/lib/blend.S'te; sonuçlar bit bit aynı olmalı */
+void blend_span(uint32_t *dst, int n, uint32_t color, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = blend_pixel(dst[i], color, alpha);
+    }
+}
+
+void blend_span_glass(uint32_t *dst, int n, uint32_t tint, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        uint32_t bg = dst[i];
+        uint32_t r = (bg >> 16) & 0xFF;
+        uint32_t g = (bg >> 8) & 0xFF;
+        uint32_t b = bg & 0xFF;
+
+        /* Açıklaştır: c + (255 - c) / 4 */
+        r += (255 - r) >> 2;
+        g += (255 - g) >> 2;
+        b += (255 - b) >> 2;
+
+        dst[i] = blend_pixel((r << 16) | (g << 8) | b, tint, alpha);
+    }
+}
+
+void blend_span_over(uint32_t *dst, const uint32_t *src, int n) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = blend_pixel_over(dst[i], src[i]);
+    }
+}
+
+void blend_span_key(uint32_t *dst, const uint32_t *src, int n, uint32_t key) {
+    for(int i = 0; i < n; i++) {
+        if(src[i] != key) dst[i] = src[i];
+    }
+}
+
+void blur_box_cols(uint32_t *dst, const uint32_t *src, int w, int h, int r) {
+    uint32_t n = 2 * r + 1;
+    uint32_t m = (65536 + n / 2) / n;
+
+    for(int x = 0; x < w; x++) {
+        for(int sh = 0; sh < 32; sh += 8) {
+            /* Kenar kelepçeli: ilk satır r+1 kez sayılır */
+            uint32_t sum = ((src[x] >> sh) & 0xFF) * (r + 1);
+            for(int k = 1; k <= r; k++) {
+                int yy = k < h - 1 ? k : h - 1;
+                sum += (src[yy * w + x] >> sh) & 0xFF;
+            }
+            for(int y = 0; y < h; y++) {
+                uint32_t v = (sum * m + 32768) >> 16;
+                dst[y * w + x] = (dst[y * w + x] & ~(0xFFu << sh)) | (v << sh);
+
+                int yin = y + r + 1 < h - 1 ? y + r + 1 : h - 1;
+                int yout = y - r > 0 ? y - r : 0;
+                sum += (src[yin * w + x] >> sh) & 0xFF;
+                sum -= (src[yout * w + x] >> sh) & 0xFF;
+            }
+        }
+    }
+}
+
+#endif
+
+#ifdef CONFIG_FB16
+
+/*
+ * RGB565 span'leri. Kanallar 5/6 bit derinliğinde karıştırılır, renk
+ * kaynağı önce aynı derinliğe indirilir; döngüler dallanmasız olduğundan
+ * derleyici NEON'a vektörleştirebilir.
+ */
+void blend565_span(uint16_t *dst, int n, uint32_t color, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = blend565_pixel(dst[i], color, alpha);
+    }
+}
+
+void blend565_span_glass(uint16_t *dst, int n, uint32_t tint, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        uint32_t bg = dst[i];
+        uint32_t r = (bg >> 11) & 0x1F;
+        uint32_t g = (bg >> 5) & 0x3F;
+        uint32_t b = bg & 0x1F;
+
+        /* Açıklaştır: c + (max - c) / 4 */
+        r += (31 - r) >> 2;
+        g += (63 - g) >> 2;
+        b += (31 - b) >> 2;
+
+        dst[i] = blend565_pixel((uint16_t)((r << 11) | (g << 5) | b), tint, alpha);
+    }
+}
+
+void blend565_span_over(uint16_t *dst, const uint32_t *src, int n) {
+    for(int i = 0; i < n; i++) {
+        uint32_t s = src[i];
+        uint32_t d = dst[i];
+        uint32_t inv = 255 - (s >> 24);
+        uint32_t r = ((s >> 19) & 0x1F) + blend_div255(((d >> 11) & 0x1F) * inv);
+        uint32_t g = ((s >> 10) & 0x3F) + blend_div255(((d >> 5) & 0x3F) * inv);
+        uint32_t b = ((s >> 3) & 0x1F) + blend_div255((d & 0x1F) * inv);
+        if(r > 31) r = 31;
+        if(g > 63) g = 63;
+        if(b > 31) b = 31;
+        dst[i] = (uint16_t)((r << 11) | (g << 5) | b);
+    }
+}
+
+void blend565_span_key(uint16_t *dst, const uint32_t *src, int n, uint32_t key) {
+    for(int i = 0; i < n; i++) {
+        if(src[i] != key) dst[i] = fb_color(src[i]);
+    }
+}
+
+void blend565_span_pack(uint16_t *dst, const uint32_t *src, int n) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = fb_color(src[i]);
+    }
+}
+
+#endif
+
+#ifdef CONFIG_FB8
+
+/* Paletli span'ler: indeks -> ARGB (fb_palette), karıştır, -> indeks (fb_color) */
+void blend8_span(uint8_t *dst, int n, uint32_t color, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = fb_color(blend_pixel(fb_argb(dst[i]), color, alpha));
+    }
+}
+
+void blend8_span_glass(uint8_t *dst, int n, uint32_t tint, uint8_t alpha) {
+    for(int i = 0; i < n; i++) {
+        uint32_t bg = fb_argb(dst[i]);
+        uint32_t r = (bg >> 16) & 0xFF;
+        uint32_t g = (bg >> 8) & 0xFF;
+        uint32_t b = bg & 0xFF;
+
+        r += (255 - r) >> 2;
+        g += (255 - g) >> 2;
+        b += (255 - b) >> 2;
+
+        dst[i] = fb_color(blend_pixel((r << 16) | (g << 8) | b, tint, alpha));
+    }
+}
+
+void blend8_span_over(uint8_t *dst, const uint32_t *src, int n) {
+    for(int i = 0; i < n; i++) {
+        uint32_t a = src[i] >> 24;
+        if(a == 255) {
+            dst[i] = fb_color(src[i]);
+        } else if(a != 0 || (src[i] & 0xFFFFFF)) {
+            dst[i] = fb_color(blend_pixel_over(fb_argb(dst[i]), src[i]));
+        }
+    }
+}
+
+void blend8_span_key(uint8_t *dst, const uint32_t *src, int n, uint32_t key) {
+    for(int i = 0; i < n; i++) {
+        if(src[i] != key) dst[i] = fb_color(src[i]);
+    }
+}
+
+void blend8_span_pack(uint8_t *dst, const uint32_t *src, int n) {
+    for(int i = 0; i < n; i++) {
+        dst[i] = fb_color(src[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,726 @@
+/* displist.c - Kalıcı çizim listesi: kayıt, karo özetleri ve kısmi raster */
+#include <displist.h>
+#include <graphics.h>
+#include <task.h>
+#include <prof.h>
+
+/* graphics.c'deki kirli karolarla aynı ızgara (32x32, 20x15) */
+#define DL_TILE_SHIFT   5
+#define DL_TILE         (1 << DL_TILE_SHIFT)
+#define DL_COLS         (SCREEN_WIDTH / DL_TILE)
+#define DL_ROWS         (SCREEN_HEIGHT / DL_TILE)
+
+/*
+ * Raster kutuları (bin): 64x64 piksel, 4 KB'lık satırlardan 16 KB'lık
+ * çalışma kümesi L1'de kalır. Her kutu 2x2 özet karosu kapsar; kutunun
+ * sadece değişen karolarını çevreleyen dikdörtgen çizilir.
+ */
+#define DL_BIN_SHIFT    6
+#define DL_BIN          (1 << DL_BIN_SHIFT)
+#define DL_BIN_COLS     ((SCREEN_WIDTH + DL_BIN - 1) / DL_BIN)      /* 10 */
+#define DL_BIN_ROWS     ((SCREEN_HEIGHT + DL_BIN - 1) / DL_BIN)     /* 8 */
+#define DL_BINS         (DL_BIN_COLS * DL_BIN_ROWS)
+#define DL_BIN_REFS     8192    /* Kutu listelerindeki toplam komut referansı */
+
+/*
+ * Örtme (occlusion): kutuda en üstteki DL_OCCLUDERS opak komut örtü olarak
+ * toplanır; altlarındaki komutlar sadece örtülmeyen parçalarında (en fazla
+ * DL_PIECES dikdörtgen, clip yığınıyla) çizilir. Parça sınırı aşılırsa
+ * kesilmemiş parça çizilir, sonuç değişmez, sadece fazla yazılır.
+ */
+#define DL_OCCLUDERS    32
+#define DL_PIECES       8
+
+#define DL_HASH_SEED    2166136261u     /* FNV-1a */
+#define DL_HASH_PRIME   16777619u
+
+typedef struct {
+    uint8_t op;
+    int x, y, w, h;
+    int a, b;
+    uint32_t c0, c1;
+    DlTextFn fn;
+    const uint32_t *pixels;         /* Blit kaynağı (b = stride, c1 = gen) */
+    uint16_t text;                  /* dl_text içindeki ofset */
+    int16_t bx, by, bw, bh;         /* Ekrana kırpılmış etki alanı */
+    uint32_t hash;
+} DlCmd;
+
+int displist_active = 0;
+
+static DlCmd dl_cmds[DL_MAX_CMDS];
+static int dl_count;
+static char dl_text[DL_TEXT_ARENA];
+static uint32_t dl_text_used;
+static int dl_overflow;
+
+static uint32_t dl_sig[DL_ROWS * DL_COLS];      /* Önceki frame'in karo özetleri */
+static int dl_force_full = 1;
+static uint32_t dl_raster_tiles;
+
+/* Bu frame çizilecek kutular ve kutu başına komut listeleri */
+typedef struct {
+    int16_t x, y, w, h;             /* Clip: kutunun değişen kısmı */
+    uint16_t bin;
+} DlBinJob;
+
+static DlBinJob dl_jobs[DL_BINS];
+static int dl_job_count;
+static uint16_t dl_bin_start[DL_BINS + 1];
+static uint16_t dl_bin_refs[DL_BIN_REFS];
+static int dl_bin_overflow;         /* Referans yetmedi: kutular tüm listeyi tarar */
+static uint32_t dl_bin_ticks[DL_BINS];
+static uint32_t dl_bin_writes[DL_BINS];     /* Kutuya yazılan piksel (parça alanları) */
+static uint32_t dl_bin_pixels[DL_BINS];
+
+typedef struct {
+    int16_t x0, y0, x1, y1;
+} DlBox;
+
+typedef struct {
+    int k;                          /* Kutu listesindeki sıra */
+    DlBox box;
+} DlOccluder;
+
+static uint32_t dl_hash_word(uint32_t h, uint32_t v) {
+    for(int i = 0; i < 4; i++) {
+        h = (h ^ (v & 0xFF)) * DL_HASH_PRIME;
+        v >>= 8;
+    }
+    return h;
+}
+
+/* Yeni komut yuvası; yer yoksa taşma işaretlenir */
+static DlCmd *dl_alloc(void) {
+    if(dl_overflow || dl_count >= DL_MAX_CMDS) {
+        dl_overflow = 1;
+        return 0;
+    }
+    return &dl_cmds[dl_count];
+}
+
+/*
+ * Etki alanını clip'e (push'lanmış clip, yoksa ekran) kırp, özeti hesapla
+ * ve komutu listeye al. Raster komutu bu alanla kırparak çizer.
+ */
+static void dl_commit(DlCmd *cmd, int bx, int by, int bw, int bh) {
+    if(!graphics_clip_rect(&bx, &by, &bw, &bh)) return;    /* Görünmez */
+
+    cmd->bx = bx;
+    cmd->by = by;
+    cmd->bw = bw;
+    cmd->bh = bh;
+
+    uint32_t h = DL_HASH_SEED;
+    h = dl_hash_word(h, cmd->op);
+    h = dl_hash_word(h, cmd->x);
+    h = dl_hash_word(h, cmd->y);
+    h = dl_hash_word(h, cmd->w);
+    h = dl_hash_word(h, cmd->h);
+    h = dl_hash_word(h, cmd->a);
+    h = dl_hash_word(h, cmd->b);
+    h = dl_hash_word(h, cmd->c0);
+    h = dl_hash_word(h, cmd->c1);
+    h = dl_hash_word(h, ((uint32_t)bx << 16) | (uint16_t)by);
+    h = dl_hash_word(h, ((uint32_t)bw << 16) | (uint16_t)bh);
+    if(cmd->op == DL_TEXT) {
+        h = dl_hash_word(h, (uint32_t)(uintptr_t)cmd->fn);
+        for(const char *s = &dl_text[cmd->text]; *s; s++) {
+            h = (h ^ (uint8_t)*s) * DL_HASH_PRIME;
+        }
+    }
+    if(cmd->pixels) {
+        uint64_t p = (uint64_t)(uintptr_t)cmd->pixels;
+        h = dl_hash_word(h, (uint32_t)p);
+        h = dl_hash_word(h, (uint32_t)(p >> 32));
+    }
+    cmd->hash = h;
+    dl_count++;
+}
+
+void displist_record(DlOp op, int x, int y, int w, int h,
+                     uint32_t c0, uint32_t c1, int a, int b) {
+    DlCmd *cmd = dl_alloc();
+    if(!cmd) return;
+
+    cmd->op = op;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->w = w;
+    cmd->h = h;
+    cmd->a = a;
+    cmd->b = b;
+    cmd->c0 = c0;
+    cmd->c1 = c1;
+    cmd->fn = 0;
+    cmd->pixels = 0;
+    cmd->text = 0;
+
+    switch(op) {
+        case DL_PIXEL:
+            dl_commit(cmd, x, y, 1, 1);
+            break;
+        case DL_CLEAR:
+        case DL_GRADIENT_BG:
+            dl_commit(cmd, 0, 0, GFX_WIDTH, GFX_HEIGHT);
+            break;
+        case DL_SHADOW:
+            /* Katmanlar sağa ve aşağıya en fazla blur + 2 taşar */
+            dl_commit(cmd, x, y, w + a + 2, h + a + 2);
+            break;
+        case DL_GLOW:
+            dl_commit(cmd, x - a, y - a, w + 2 * a, h + 2 * a);
+            break;
+        case DL_LINE_H:
+            dl_commit(cmd, x, y, w, 1);
+            break;
+        case DL_LINE_V:
+            dl_commit(cmd, x, y, 1, h);
+            break;
+        default:
+            dl_commit(cmd, x, y, w, h);
+            break;
+    }
+}
+
+void displist_text(DlTextFn fn, DlTextWidthFn width, int height,
+                   int x, int y, const char *text, uint32_t color) {
+    if(!displist_active) {
+        fn(x, y, text, color);
+        return;
+    }
+
+    DlCmd *cmd = dl_alloc();
+    if(!cmd) return;
+
+    /* Metni kopyala: çağıranın tamponu raster sırasında geçerli olmayabilir */
+    uint32_t len = 0;
+    while(text[len]) len++;
+    if(dl_text_used + len + 1 > DL_TEXT_ARENA) {
+        dl_overflow = 1;
+        return;
+    }
+    memcpy(&dl_text[dl_text_used], text, len + 1);
+
+    cmd->op = DL_TEXT;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->w = width(text);
+    cmd->h = height;
+    cmd->a = 0;
+    cmd->b = 0;
+    cmd->c0 = color;
+    cmd->c1 = 0;
+    cmd->fn = fn;
+    cmd->pixels = 0;
+    cmd->text = (uint16_t)dl_text_used;
+    dl_text_used += len + 1;
+
+    dl_commit(cmd, x, y, cmd->w, height);
+}
+
+void displist_blit(DlOp op, const Surface *src, int x, int y, uint32_t key) {
+    if(!src || !src->pixels) return;
+
+    DlCmd *cmd = dl_alloc();
+    if(!cmd) return;
+
+    cmd->op = op;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->w = src->w;
+    cmd->h = src->h;
+    cmd->a = src->format;
+    cmd->b = src->stride;
+    cmd->c0 = key;
+    cmd->c1 = src->gen;
+    cmd->fn = 0;
+    cmd->pixels = src->pixels;
+    cmd->text = 0;
+
+    dl_commit(cmd, x, y, src->w, src->h);
+}
+
+/* Kayıttaki alanlardan yüzeyi yeniden kur */
+static void dl_surface(const DlCmd *c, Surface *s) {
+    s->w = c->w;
+    s->h = c->h;
+    s->stride = c->b;
+    s->format = c->a;
+    s->pixels = (uint32_t *)c->pixels;
+    s->gen = c->c1;
+}
+
+/* Komutu gerçekten çiz (kayıt kapalıyken, clip ayarlı) */
+static void dl_replay(const DlCmd *c) {
+    Surface surf;
+
+    switch(c->op) {
+        case DL_PIXEL:          draw_pixel(c->x, c->y, c->c0); break;
+        case DL_RECT:           draw_rect(c->x, c->y, c->w, c->h, c->c0); break;
+        case DL_RECT_ALPHA:     draw_rect_alpha(c->x, c->y, c->w, c->h, c->c0, (uint8_t)c->a); break;
+        case DL_CLEAR:          clear_screen(c->c0); break;
+        case DL_GRADIENT_BG:    draw_gradient_bg(c->c0, c->c1); break;
+        case DL_GRADIENT_RECT:  draw_gradient_rect(c->x, c->y, c->w, c->h, c->c0, c->c1); break;
+        case DL_GLASS:          graphics_glass_panel(c->x, c->y, c->w, c->h, c->c0, (uint8_t)c->a, c->c1); break;
+        case DL_ROUNDED:        draw_rounded_rect(c->x, c->y, c->w, c->h, c->a, c->c0); break;
+        case DL_ROUNDED_ALPHA:  draw_rounded_rect_alpha(c->x, c->y, c->w, c->h, c->a, c->c0, (uint8_t)c->b); break;
+        case DL_SHADOW:         draw_shadow(c->x, c->y, c->w, c->h, c->a, (uint8_t)c->b); break;
+        case DL_GLOW:           draw_glow(c->x, c->y, c->w, c->h, c->c0, c->a); break;
+        case DL_LINE_H:         draw_line_h(c->x, c->y, c->w, c->c0); break;
+        case DL_LINE_V:         draw_line_v(c->x, c->y, c->h, c->c0); break;
+        case DL_TEXT:           c->fn(c->x, c->y, &dl_text[c->text], c->c0); break;
+        case DL_BLIT:           dl_surface(c, &surf); blit(&surf, c->x, c->y); break;
+        case DL_BLIT_ALPHA:     dl_surface(c, &surf); blit_alpha(&surf, c->x, c->y); break;
+        case DL_BLIT_KEY:       dl_surface(c, &surf); blit_colorkey(&surf, c->x, c->y, c->c0); break;
+    }
+}
+
+static int dl_intersects(const DlCmd *c, int x, int y, int w, int h) {
+    return c->bx < x + w && x < c->bx + c->bw && c->by < y + h && y < c->by + c->bh;
+}
+
+/* Etki alanının her pikselini opak yazar mı? */
+static int dl_opaque(const DlCmd *c) {
+    return c->op == DL_RECT || c->op == DL_CLEAR || c->op == DL_BLIT ||
+           c->op == DL_GRADIENT_BG || c->op == DL_GRADIENT_RECT;
+}
+
+/* Bölgeyi tamamen ve opak olarak kaplıyor mu? (altındakiler çizilmez) */
+static int dl_covers(const DlCmd *c, int x, int y, int w, int h) {
+    if(!dl_opaque(c)) return 0;
+    return c->bx <= x && c->by <= y && c->bx + c->bw >= x + w && c->by + c->bh >= y + h;
+}
+
+/* Komutu etki alanı ve box ile kırparak çiz */
+static void dl_draw(const DlCmd *c, const DlBox *box) {
+    if(graphics_push_clip(box->x0, box->y0, box->x1 - box->x0, box->y1 - box->y0) < 0) return;
+    if(c) {
+        if(graphics_push_clip(c->bx, c->by, c->bw, c->bh) == 0) {
+            dl_replay(c);
+            graphics_pop_clip();
+        }
+    } else {
+        draw_rect(box->x0, box->y0, box->x1 - box->x0, box->y1 - box->y0, COLOR_BLACK);
+    }
+    graphics_pop_clip();
+}
+
+/* CNTPCT: çekirdekler arası ortak sayaç (karo süreleri) */
+static inline uint64_t dl_ticks(void) {
+    uint64_t t;
+    __asm__ volatile("isb\n"
+                     "mrs %0, cntpct_el0" : "=r"(t) : : "memory");
+    return t;
+}
+
+/*
+ * Komutları değişen kutulara dağıt (sayarak sıralama): önce kutu başına
+ * sayı, sonra başlangıçlar, sonra sırayı koruyarak doldurma.
+ */
+static void dl_bin_commands(const uint8_t *bin_damaged) {
+    uint16_t fill[DL_BINS];
+    uint32_t total = 0;
+
+    for(int b = 0; b < DL_BINS; b++) {
+        fill[b] = 0;
+    }
+
+    for(int i = 0; i < dl_count; i++) {
+        const DlCmd *c = &dl_cmds[i];
+        for(int r = c->by >> DL_BIN_SHIFT; r <= (c->by + c->bh - 1) >> DL_BIN_SHIFT; r++) {
+            for(int col = c->bx >> DL_BIN_SHIFT; col <= (c->bx + c->bw - 1) >> DL_BIN_SHIFT; col++) {
+                int b = r * DL_BIN_COLS + col;
+                if(bin_damaged[b]) {
+                    fill[b]++;
+                    total++;
+                }
+            }
+        }
+    }
+
+    dl_bin_overflow = total > DL_BIN_REFS;
+    if(dl_bin_overflow) return;
+
+    dl_bin_start[0] = 0;
+    for(int b = 0; b < DL_BINS; b++) {
+        dl_bin_start[b + 1] = dl_bin_start[b] + fill[b];
+        fill[b] = dl_bin_start[b];
+    }
+
+    for(int i = 0; i < dl_count; i++) {
+        const DlCmd *c = &dl_cmds[i];
+        for(int r = c->by >> DL_BIN_SHIFT; r <= (c->by + c->bh - 1) >> DL_BIN_SHIFT; r++) {
+            for(int col = c->bx >> DL_BIN_SHIFT; col <= (c->bx + c->bw - 1) >> DL_BIN_SHIFT; col++) {
+                int b = r * DL_BIN_COLS + col;
+                if(bin_damaged[b]) {
+                    dl_bin_refs[fill[b]++] = (uint16_t)i;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Parçalardan o'yu çıkar: kesişen parça üst, alt, sol ve sağ şeritlere
+ * bölünür. Yer yetmezse parça olduğu gibi kalır. Dönüş: yeni parça sayısı.
+ */
+static int dl_subtract(DlBox *pieces, int n, const DlBox *o) {
+    DlBox out[DL_PIECES];
+    int m = 0;
+
+    for(int i = 0; i < n; i++) {
+        const DlBox *p = &pieces[i];
+        if(o->x0 >= p->x1 || o->x1 <= p->x0 || o->y0 >= p->y1 || o->y1 <= p->y0) {
+            if(m < DL_PIECES) out[m++] = *p;
+            continue;
+        }
+
+        DlBox parts[4];
+        int k = 0;
+        int16_t y0 = o->y0 > p->y0 ? o->y0 : p->y0;
+        int16_t y1 = o->y1 < p->y1 ? o->y1 : p->y1;
+        if(o->y0 > p->y0) parts[k++] = (DlBox){ p->x0, p->y0, p->x1, o->y0 };
+        if(o->y1 < p->y1) parts[k++] = (DlBox){ p->x0, o->y1, p->x1, p->y1 };
+        if(o->x0 > p->x0) parts[k++] = (DlBox){ p->x0, y0, o->x0, y1 };
+        if(o->x1 < p->x1) parts[k++] = (DlBox){ o->x1, y0, p->x1, y1 };
+
+        if(m + k > DL_PIECES - (n - i - 1)) {
+            out[m++] = *p;          /* Kalan parçalara yer bırak */
+            continue;
+        }
+        for(int j = 0; j < k; j++) {
+            out[m++] = parts[j];
+        }
+    }
+
+    for(int i = 0; i < m; i++) {
+        pieces[i] = out[i];
+    }
+    return m;
+}
+
+#ifdef CONFIG_OVERDRAW
+/* Isı haritası: 1 yazım renksiz, 2 mavi, 3 yeşil, 4 pembe, 5+ kırmızı */
+static const uint32_t dl_heat_colors[4] = {
+    0xFF2060FF, 0xFF20C040, 0xFFFF60C0, 0xFFFF2020
+};
+
+static void dl_heat_add(uint8_t *heat, const DlBinJob *job, const DlBox *b) {
+    for(int y = b->y0; y < b->y1; y++) {
+        uint8_t *row = &heat[(y - job->y) * DL_BIN];
+        for(int x = b->x0; x < b->x1; x++) {
+            if(row[x - job->x] < 255) row[x - job->x]++;
+        }
+    }
+}
+
+/* Kutunun sayaçlarını aynı sayılı yatay şeritler halinde boya */
+static void dl_heat_draw(const uint8_t *heat, const DlBinJob *job) {
+    for(int y = 0; y < job->h; y++) {
+        const uint8_t *row = &heat[y * DL_BIN];
+        int x = 0;
+        while(x < job->w) {
+            int n = row[x];
+            int e = x + 1;
+            while(e < job->w && row[e] == n) e++;
+            if(n >= 2) {
+                uint32_t color = dl_heat_colors[(n > 5 ? 5 : n) - 2];
+                draw_rect_alpha(job->x + x, job->y + y, e - x, 1, color, 144);
+            }
+            x = e;
+        }
+    }
+}
+#endif
+
+/*
+ * Kutuyu kendi clip'iyle çiz. Önden arkaya geçiş opak örtüleri toplar ve
+ * kutuyu tamamen örten en üstteki komutta durur; sonra arkadan öne her
+ * komut sadece üstündeki örtülerin bıraktığı parçalarda çizilir.
+ */
+static void dl_raster_bin(const DlBinJob *job) {
+    const uint16_t *refs = &dl_bin_refs[dl_bin_start[job->bin]];
+    int n = dl_bin_overflow ? dl_count : dl_bin_start[job->bin + 1] - dl_bin_start[job->bin];
+    DlBox bin = { job->x, job->y, job->x + job->w, job->y + job->h };
+    DlOccluder occ[DL_OCCLUDERS];
+    int occ_count = 0;
+    int first = -1;
+    uint32_t writes = 0;
+#ifdef CONFIG_OVERDRAW
+    uint8_t heat[DL_BIN * DL_BIN];
+    memset(heat, 0, sizeof(heat));
+#endif
+
+    for(int k = n - 1; k >= 0; k--) {
+        const DlCmd *c = &dl_cmds[dl_bin_overflow ? k : refs[k]];
+        if(!dl_opaque(c) || !dl_intersects(c, job->x, job->y, job->w, job->h)) continue;
+        if(dl_covers(c, job->x, job->y, job->w, job->h)) {
+            first = k;
+            break;
+        }
+        if(occ_count < DL_OCCLUDERS) {
+            DlOccluder *o = &occ[occ_count++];
+            o->k = k;
+            o->box.x0 = c->bx > bin.x0 ? c->bx : bin.x0;
+            o->box.y0 = c->by > bin.y0 ? c->by : bin.y0;
+            o->box.x1 = c->bx + c->bw < bin.x1 ? c->bx + c->bw : bin.x1;
+            o->box.y1 = c->by + c->bh < bin.y1 ? c->by + c->bh : bin.y1;
+        }
+    }
+
+    graphics_set_clip(job->x, job->y, job->w, job->h);
+
+    /* Altta örtü yoksa tam çizimle aynı sonuç için bölge siyahlanır (k = -1) */
+    for(int k = first < 0 ? -1 : first; k < n; k++) {
+        const DlCmd *c = k < 0 ? 0 : &dl_cmds[dl_bin_overflow ? k : refs[k]];
+        DlBox pieces[DL_PIECES];
+
+        if(c) {
+            if(!dl_intersects(c, job->x, job->y, job->w, job->h)) continue;
+            pieces[0].x0 = c->bx > bin.x0 ? c->bx : bin.x0;
+            pieces[0].y0 = c->by > bin.y0 ? c->by : bin.y0;
+            pieces[0].x1 = c->bx + c->bw < bin.x1 ? c->bx + c->bw : bin.x1;
+            pieces[0].y1 = c->by + c->bh < bin.y1 ? c->by + c->bh : bin.y1;
+        } else {
+            pieces[0] = bin;
+        }
+
+        /* occ k'ye göre azalan sırada: sadece üstteki örtüler çıkarılır */
+        int np = 1;
+        for(int i = 0; i < occ_count && occ[i].k > k && np > 0; i++) {
+            np = dl_subtract(pieces, np, &occ[i].box);
+        }
+
+        for(int i = 0; i < np; i++) {
+            dl_draw(c, &pieces[i]);
+            writes += (pieces[i].x1 - pieces[i].x0) * (pieces[i].y1 - pieces[i].y0);
+#ifdef CONFIG_OVERDRAW
+            dl_heat_add(heat, job, &pieces[i]);
+#endif
+        }
+    }
+
+#ifdef CONFIG_OVERDRAW
+    dl_heat_draw(heat, job);
+#endif
+    graphics_reset_clip();
+
+    dl_bin_writes[job->bin] = writes;
+    dl_bin_pixels[job->bin] = job->w * job->h;
+}
+
+static void dl_raster_range(int begin, int end, void *arg) {
+    (void)arg;
+    for(int j = begin; j < end; j++) {
+        uint64_t t0 = dl_ticks();
+        dl_raster_bin(&dl_jobs[j]);
+        dl_bin_ticks[dl_jobs[j].bin] = (uint32_t)(dl_ticks() - t0);
+    }
+}
+
+/* Değişen karo maskesinden kutu işlerini çıkar */
+static void dl_build_jobs(const uint32_t *damage, uint8_t *bin_damaged) {
+    dl_job_count = 0;
+
+    for(int br = 0; br < DL_BIN_ROWS; br++) {
+        for(int bc = 0; bc < DL_BIN_COLS; bc++) {
+            int b = br * DL_BIN_COLS + bc;
+            int r = br * 2;
+            uint32_t m0 = (damage[r] >> (bc * 2)) & 3;
+            uint32_t m1 = (r + 1 < DL_ROWS) ? (damage[r + 1] >> (bc * 2)) & 3 : 0;
+            uint32_t cols = m0 | m1;
+
+            bin_damaged[b] = cols != 0;
+            dl_bin_ticks[b] = 0;
+            dl_bin_writes[b] = 0;
+            dl_bin_pixels[b] = 0;
+            if(!cols) continue;
+
+            int cx0 = (cols & 1) ? 0 : 1;
+            int cx1 = (cols & 2) ? 2 : 1;
+            int ry0 = m0 ? 0 : 1;
+            int ry1 = m1 ? 2 : 1;
+
+            DlBinJob *job = &dl_jobs[dl_job_count++];
+            job->x = bc * DL_BIN + cx0 * DL_TILE;
+            job->y = br * DL_BIN + ry0 * DL_TILE;
+            job->w = (cx1 - cx0) * DL_TILE;
+            job->h = (ry1 - ry0) * DL_TILE;
+            /* Ölçekli modda son karolar aktif alandan taşabilir */
+            if(job->x + job->w > GFX_WIDTH) job->w = GFX_WIDTH - job->x;
+            if(job->y + job->h > GFX_HEIGHT) job->h = GFX_HEIGHT - job->y;
+            job->bin = b;
+        }
+    }
+}
+
+/*
+ * Cam paneli altındakini bulanıklaştırır: sonucu panelin altında kalan
+ * komutlara bağlıdır. Anahtar, önceki komutlardan panele değenlerin
+ * özetleridir (c1'e yazılır) ve camın özetine katılır; alttaki bir
+ * değişiklik panelin tüm karolarını değiştirir ve önbelleği ıskalatır.
+ */
+static void dl_glass_keys(void) {
+    for(int i = 0; i < dl_count; i++) {
+        DlCmd *g = &dl_cmds[i];
+        if(g->op != DL_GLASS) continue;
+
+        uint32_t key = g->hash;
+        for(int j = 0; j < i; j++) {
+            if(dl_intersects(&dl_cmds[j], g->bx, g->by, g->bw, g->bh)) {
+                key = (key ^ dl_cmds[j].hash) * DL_HASH_PRIME;
+            }
+        }
+        key |= 1;                   /* 0 = önbelleksiz doğrudan çizim */
+        g->c1 = key;
+        g->hash = key;
+    }
+}
+
+static int dl_glass_index;
+
+/* Panelin altındaki komutları (cam dahil, sırayla) yeniden çiz */
+static void dl_glass_replay(void *arg) {
+    const DlCmd *g = (const DlCmd *)arg;
+
+    DlBox box = { g->bx, g->by, g->bx + g->bw, g->by + g->bh };
+
+    dl_draw(0, &box);
+    for(int j = 0; j < dl_glass_index; j++) {
+        if(dl_intersects(&dl_cmds[j], g->bx, g->by, g->bw, g->bh)) {
+            dl_draw(&dl_cmds[j], &box);
+        }
+    }
+}
+
+/*
+ * Önbellekte olmayan camları karo raster'ından önce hazırla. Önce önbellekte
+ * bulunanlar sabitlenir, böylece yeni yakalamalar onları çıkaramaz.
+ */
+static void dl_glass_prepare(void) {
+    graphics_glass_begin_frame();
+    for(int i = 0; i < dl_count; i++) {
+        if(dl_cmds[i].op == DL_GLASS) graphics_glass_cached(dl_cmds[i].c1);
+    }
+
+    for(int i = 0; i < dl_count; i++) {
+        const DlCmd *g = &dl_cmds[i];
+        if(g->op != DL_GLASS || graphics_glass_cached(g->c1)) continue;
+
+        dl_glass_index = i;
+        graphics_glass_prepare(g->x, g->y, g->w, g->h, g->c0, (uint8_t)g->a,
+                               g->c1, dl_glass_replay, (void *)g);
+    }
+}
+
+/*
+ * Karo özetleri: karoya değen komutların özetleri sırayla birleştirilir,
+ * böylece içerik, konum ve üst üste binme sırası değişiklikleri yakalanır.
+ * Değişen karoların maskesi damage'e yazılır, yeni özetler saklanır.
+ */
+static uint32_t dl_compute_damage(uint32_t *damage) {
+    static uint32_t sig[DL_ROWS * DL_COLS];
+    uint32_t tiles = 0;
+
+    for(int i = 0; i < DL_ROWS * DL_COLS; i++) {
+        sig[i] = DL_HASH_SEED;
+    }
+
+    for(int i = 0; i < dl_count; i++) {
+        const DlCmd *c = &dl_cmds[i];
+        int c0 = c->bx >> DL_TILE_SHIFT;
+        int c1 = (c->bx + c->bw - 1) >> DL_TILE_SHIFT;
+        int r0 = c->by >> DL_TILE_SHIFT;
+        int r1 = (c->by + c->bh - 1) >> DL_TILE_SHIFT;
+
+        for(int r = r0; r <= r1; r++) {
+            for(int col = c0; col <= c1; col++) {
+                uint32_t *s = &sig[r * DL_COLS + col];
+                *s = (*s ^ c->hash) * DL_HASH_PRIME;
+            }
+        }
+    }
+
+    /* Aktif alan dışındaki karolar (graphics_set_scale) hiç çizilmez */
+    int rows = (GFX_HEIGHT + DL_TILE - 1) >> DL_TILE_SHIFT;
+    int cols = (GFX_WIDTH + DL_TILE - 1) >> DL_TILE_SHIFT;
+
+    for(int r = 0; r < DL_ROWS; r++) {
+        damage[r] = 0;
+        for(int col = 0; col < DL_COLS; col++) {
+            int t = r * DL_COLS + col;
+            if(r >= rows || col >= cols) {
+                dl_sig[t] = DL_HASH_SEED;
+                continue;
+            }
+            if(dl_force_full || sig[t] != dl_sig[t]) {
+                damage[r] |= 1u << col;
+                tiles++;
+            }
+            dl_sig[t] = sig[t];
+        }
+    }
+    dl_force_full = 0;
+    return tiles;
+}
+
+int displist_render(void (*render)(void)) {
+    uint32_t damage[DL_ROWS];
+
+    dl_count = 0;
+    dl_text_used = 0;
+    dl_overflow = 0;
+
+    displist_active = 1;
+    render();
+    displist_active = 0;
+
+    if(dl_overflow) {
+        /* Liste yetmedi: doğrudan çiz, özetler artık geçersiz */
+        render();
+        dl_force_full = 1;
+        dl_raster_tiles = DL_ROWS * DL_COLS;
+        return 1;
+    }
+
+    dl_glass_keys();
+    dl_raster_tiles = dl_compute_damage(damage);
+    if(dl_raster_tiles == 0) return 0;
+
+    PROF_ZONE("raster");
+    uint8_t bin_damaged[DL_BINS];
+
+    dl_glass_prepare();
+
+    dl_build_jobs(damage, bin_damaged);
+    dl_bin_commands(bin_damaged);
+
+    /* Kirli işaretleme çekirdek 0'da, sonra kutular çekirdeklere */
+    for(int j = 0; j < dl_job_count; j++) {
+        graphics_mark_dirty(dl_jobs[j].x, dl_jobs[j].y, dl_jobs[j].w, dl_jobs[j].h);
+    }
+    graphics_tiles_begin();
+    parallel_for(0, dl_job_count, 1, dl_raster_range, 0);
+    graphics_tiles_end();
+
+    prof_tiles(dl_bin_ticks, DL_BIN_COLS, DL_BIN_ROWS);
+    return 1;
+}
+
+void displist_invalidate(void) {
+    dl_force_full = 1;
+}
+
+uint32_t displist_raster_tiles(void) {
+    return dl_raster_tiles;
+}
+
+uint32_t displist_overdraw(void) {
+    uint32_t writes = 0, pixels = 0;
+    for(int b = 0; b < DL_BINS; b++) {
+        writes += dl_bin_writes[b];
+        pixels += dl_bin_pixels[b];
+    }
+    return pixels ? writes * 100 / pixels : 0;
+}
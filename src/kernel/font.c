@@ -209,6 +209,9 @@ void draw_char_aa(int x, int y, char c, uint32_t color, int scale) {
     uint8_t b = (color & 0xFF) / 2;
     uint32_t aa_color = 0xFF000000 | (r << 16) | (g << 8) | b;
 
+    /* Clip dışında kalan glif atlanır (AA kenarları 1 piksel taşar) */
+    if(!graphics_clip_test(x - 1, y - 1, 8 * scale + 2, 12 * scale + 2)) return;
+
     /* Önce ana pikselleri çiz */
     for(int row = 0; row < 12; row++) {
         uint8_t line = font_data[idx][row];
@@ -2185,6 +2185,9 @@ void draw_char_inter(int x, int y, char c, uint32_t color) {
     const FontGlyph* glyph = &font_glyphs[idx];
     const uint8_t* pixels = &font_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, FONT_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
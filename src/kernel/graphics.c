@@ -1,107 +1,386 @@
 /* graphics.c - Modern UI grafik fonksiyonları (çift tamponlama destekli) */
 #include <graphics.h>
+#include <task.h>
+#include <smp.h>
+#include <mm.h>
+#include <mmu.h>
+#include <blend.h>
+#include <fb.h>
+#include <displist.h>
+#include <hw.h>
+#include <drivers/dma.h>
+
+/* parallel_for ile satır döngülerinde çekirdek başına en az satır */
+#define ROW_GRAIN   32
 
 /* Framebuffer değişkenleri */
 uint32_t screen_width, screen_height, screen_pitch;
+uint32_t screen_virtual_height;
 uint8_t *framebuffer;
 
-/* Çift tamponlama için statik back buffer */
-/* 640 x 480 x 4 bytes = 1,228,800 bytes (~1.2MB) */
-static uint8_t back_buffer_data[SCREEN_WIDTH * SCREEN_HEIGHT * 4] __attribute__((aligned(16)));
+/*
+ * Çift tamponlama:
+ *   Sayfa çevirme: framebuffer 640x960, draw_buffer görünmeyen yarı.
+ *     Swap = önbelleği temizle + tek mailbox çağrısı (0x48009), kopya yok.
+ *   Kopya: back buffer (sayfa ayırıcıdan) her frame framebuffer'a kopyalanır.
+ *     Firmware sanal ofseti reddederse bu yola düşülür. DMA varsa iki back
+ *     buffer dönüşümlü kullanılır: biri DMA ile sunulurken diğerine çizilir.
+ */
+/* 640 x 480 x 4 bytes = 1,228,800 bytes (~1.2MB), RGB565'te yarısı */
+#define BACK_BUFFER_SIZE    (FB_STRIDE * SCREEN_HEIGHT)
 
 /* Buffer pointer'ları */
 uint8_t *draw_buffer;      /* Çizim yapılan buffer (back buffer) */
 uint8_t *display_buffer;   /* Görüntülenen buffer (framebuffer) */
+int graphics_page_flip = 0;
+
+static int front_page = 0;         /* Görüntülenen yarı (0 = üst, 1 = alt) */
+static int display_cached = 0;     /* display_buffer önbellekli eşlemede mi? */
+
+static uint8_t *back_buffers[2];   /* Kopya modu (DMA varsa ikisi de) */
+static int back_index = 0;         /* draw_buffer = back_buffers[back_index] */
+static int present_dma = 0;        /* Sunum DMA ile mi? */
+static int fill_pending = 0;       /* draw_buffer'a DMA doldurma sürüyor */
+static uint8_t *fill_dst;          /* Süren doldurmanın bölgesi */
+static uint32_t fill_len;
+
+/* Bu büyüklükten (bayt) itibaren tam genişlik dolgular DMA'ya gider */
+#define DMA_FILL_MIN        (64 * 1024)
+
+/* Süren DMA doldurmasını bekle; sonrasında CPU draw_buffer'ı okuyabilir */
+static void graphics_dma_sync(void) {
+    dma_wait(DMA_CH_FILL);
+    /* Aktarım sırasında spekülatif olarak önbelleğe gelmiş eski satırları at */
+    dcache_invalidate_range(fill_dst, fill_len);
+    fill_pending = 0;
+}
+
+/* Sanal framebuffer'daki yarının adresi */
+static uint8_t *fb_page(int page) {
+    return framebuffer + (uint32_t)page * screen_height * screen_pitch;
+}
+
+/*
+ * Kirli bölge takibi: ekran 32x32 piksellik karolara bölünür, her karo
+ * satırı bir bit maskesidir (20 sütun). Çizim fonksiyonları dokundukları
+ * alanı işaretler; swap sadece kirli karoları kopyalar / önbellekten
+ * temizler. İşaretleme çekirdek 0'da yapılır: parallel_for kullanan
+ * fonksiyonlar alanı işi dağıtmadan önce işaretler.
+ */
+#define DIRTY_TILE_SHIFT    5
+#define DIRTY_TILE          (1 << DIRTY_TILE_SHIFT)
+#define DIRTY_COLS          (SCREEN_WIDTH / DIRTY_TILE)     /* 20 */
+#define DIRTY_ROWS          (SCREEN_HEIGHT / DIRTY_TILE)    /* 15 */
+#define DIRTY_ALL           ((1u << DIRTY_COLS) - 1)
+
+static uint32_t dirty_tiles[DIRTY_ROWS];        /* Bu frame çizilen karolar */
+static uint32_t prev_dirty_tiles[DIRTY_ROWS];   /* Sayfa çevirme: iki yarının farkı */
+static int dirty_force_full = 1;                /* Sonraki swap tüm ekranı sunar */
+static uint32_t presented_bytes = 0;            /* Son swap'ta taşınan bayt */
+
+/*
+ * Clip dikdörtgeni [x0, x1) x [y0, y1): displist karo raster sırasında
+ * ayarlar. Karolar farklı çekirdeklerde çizildiği için her çekirdeğin
+ * kendi clip'i var. Kırpma sadece kısıtlar; clip içindeki pikseller tam
+ * ekran çizimle birebir aynı çıkar. push/pop önceki clip'leri yığında
+ * saklar; set/reset clip'i değiştirip yığını boşaltır (eski kutular geri
+ * yüklenmez).
+ */
+#define CLIP_STACK_DEPTH    8
+
+typedef struct {
+    int x0, y0, x1, y1;
+} ClipBox;
+
+typedef struct {
+    int x0, y0, x1, y1;
+    int depth;
+    ClipBox saved[CLIP_STACK_DEPTH];
+} __attribute__((aligned(64))) ClipRect;
+
+static ClipRect clips[SMP_MAX_CORES] = {
+    [0 ... SMP_MAX_CORES - 1] = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }
+};
+
+/* Karo modu: kirli işaretleme, DMA dolgu ve iç parallel_for kapalı */
+static volatile int tiles_active = 0;
 
-/* Inline memcpy for buffer copy */
-static void fast_memcpy32(uint32_t *dst, uint32_t *src, uint32_t count) {
-    while(count >= 8) {
-        dst[0] = src[0];
-        dst[1] = src[1];
-        dst[2] = src[2];
-        dst[3] = src[3];
-        dst[4] = src[4];
-        dst[5] = src[5];
-        dst[6] = src[6];
-        dst[7] = src[7];
-        dst += 8;
-        src += 8;
-        count -= 8;
+static inline ClipRect *cur_clip(void) {
+    return &clips[smp_core_id()];
+}
+
+void graphics_set_clip(int x, int y, int w, int h) {
+    ClipRect *c = cur_clip();
+    c->depth = 0;
+    c->x0 = x < 0 ? 0 : x;
+    c->y0 = y < 0 ? 0 : y;
+    c->x1 = x + w > GFX_WIDTH ? GFX_WIDTH : x + w;
+    c->y1 = y + h > GFX_HEIGHT ? GFX_HEIGHT : y + h;
+}
+
+void graphics_reset_clip(void) {
+    graphics_set_clip(0, 0, GFX_WIDTH, GFX_HEIGHT);
+}
+
+int graphics_push_clip(int x, int y, int w, int h) {
+    ClipRect *c = cur_clip();
+    if(c->depth >= CLIP_STACK_DEPTH) return -1;
+
+    ClipBox *s = &c->saved[c->depth++];
+    s->x0 = c->x0;
+    s->y0 = c->y0;
+    s->x1 = c->x1;
+    s->y1 = c->y1;
+
+    if(x > c->x0) c->x0 = x;
+    if(y > c->y0) c->y0 = y;
+    if(x + w < c->x1) c->x1 = x + w;
+    if(y + h < c->y1) c->y1 = y + h;
+
+    /* Kesişim boşsa sıfır alanlı clip: hiçbir şey çizilmez */
+    if(c->x1 < c->x0 || c->y1 < c->y0) {
+        c->x1 = c->x0;
+        c->y1 = c->y0;
     }
-    while(count--) {
-        *dst++ = *src++;
+    return 0;
+}
+
+void graphics_pop_clip(void) {
+    ClipRect *c = cur_clip();
+    if(c->depth == 0) return;
+
+    const ClipBox *s = &c->saved[--c->depth];
+    c->x0 = s->x0;
+    c->y0 = s->y0;
+    c->x1 = s->x1;
+    c->y1 = s->y1;
+}
+
+static int clip_is_full(void) {
+    ClipRect *c = cur_clip();
+    return c->x0 == 0 && c->y0 == 0 && c->x1 == GFX_WIDTH && c->y1 == GFX_HEIGHT;
+}
+
+/* Dikdörtgeni clip'e kırp; boş kalırsa 0 */
+static int clip_rect(int *x, int *y, int *w, int *h) {
+    ClipRect *c = cur_clip();
+    int x0 = *x, y0 = *y;
+    int x1 = *x + *w, y1 = *y + *h;
+
+    if(x0 < c->x0) x0 = c->x0;
+    if(y0 < c->y0) y0 = c->y0;
+    if(x1 > c->x1) x1 = c->x1;
+    if(y1 > c->y1) y1 = c->y1;
+    if(x1 <= x0 || y1 <= y0) return 0;
+
+    *x = x0;
+    *y = y0;
+    *w = x1 - x0;
+    *h = y1 - y0;
+    return 1;
+}
+
+int graphics_clip_rect(int *x, int *y, int *w, int *h) {
+    return clip_rect(x, y, w, h);
+}
+
+int graphics_clip_test(int x, int y, int w, int h) {
+    const ClipRect *c = cur_clip();
+    return x < c->x1 && x + w > c->x0 && y < c->y1 && y + h > c->y0;
+}
+
+static inline int clip_point(int x, int y) {
+    ClipRect *c = cur_clip();
+    return x >= c->x0 && x < c->x1 && y >= c->y0 && y < c->y1;
+}
+
+/* draw_buffer'da (x, y) pikselinin adresi */
+static inline fb_pixel_t *fb_row(int x, int y) {
+    return (fb_pixel_t *)(draw_buffer + y * FB_STRIDE) + x;
+}
+
+static inline void fb_fill(fb_pixel_t *row, int n, fb_pixel_t color) {
+    for(int i = 0; i < n; i++) {
+        row[i] = color;
     }
 }
 
-/* Piksel okuma (alpha blending için) */
-static uint32_t read_pixel(int x, int y) {
-    if(x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return 0;
-    uint32_t offset = (y * SCREEN_WIDTH * 4) + (x * 4);
-    return *((uint32_t *)(draw_buffer + offset));
+#ifdef CONFIG_FB16_DITHER
+/*
+ * Gradyanlar için sıralı titreştirme (4x4 Bayer): 565'e yuvarlamadan önce
+ * kanala konuma bağlı eşik eklenir, bantlar ince bir desene dönüşür.
+ * Eşik sadece ekran konumuna bağlı: karo raster sonucu değişmez.
+ */
+static const uint8_t dither_bayer[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 }
+};
+
+static fb_pixel_t dither_color(uint32_t argb, int x, int y) {
+    uint32_t t = dither_bayer[y & 3][x & 3];
+    uint32_t r = ((argb >> 16) & 0xFF) + (t >> 1);     /* 5 bit: adım 8 */
+    uint32_t g = ((argb >> 8) & 0xFF) + (t >> 2);      /* 6 bit: adım 4 */
+    uint32_t b = (argb & 0xFF) + (t >> 1);
+    if(r > 255) r = 255;
+    if(g > 255) g = 255;
+    if(b > 255) b = 255;
+    return fb_color((r << 16) | (g << 8) | b);
 }
+#endif
 
-/* Alpha blend iki rengi */
-static uint32_t blend_colors(uint32_t bg, uint32_t fg, uint8_t alpha) {
-    uint8_t inv_alpha = 255 - alpha;
+/* Gradyan satırı: düz renk veya (FB16_DITHER) 4 sütun fazlı desen */
+static void gradient_fill(int x, int y, int w, uint32_t color) {
+    fb_pixel_t *row = fb_row(x, y);
+#ifdef CONFIG_FB16_DITHER
+    fb_pixel_t phase[4];
+    for(int i = 0; i < 4; i++) {
+        phase[i] = dither_color(color, x + i, y);
+    }
+    for(int i = 0; i < w; i++) {
+        row[i] = phase[i & 3];
+    }
+#else
+    fb_fill(row, w, fb_color(color));
+#endif
+}
 
-    uint8_t bg_r = (bg >> 16) & 0xFF;
-    uint8_t bg_g = (bg >> 8) & 0xFF;
-    uint8_t bg_b = bg & 0xFF;
+/*
+ * Karo modu: çağıran (çekirdek 0) çizilecek karoları önceden işaretler,
+ * sonra karolar çekirdeklere dağıtılır. Bu sürede çizim fonksiyonları
+ * paylaşılan kirli maskeye yazmaz, DMA başlatmaz ve satırları kendi
+ * çekirdeğinde çizer (karo zaten tek çekirdeğin işi).
+ */
+void graphics_tiles_begin(void) {
+    if(fill_pending) graphics_dma_sync();
+    tiles_active = 1;
+}
 
-    uint8_t fg_r = (fg >> 16) & 0xFF;
-    uint8_t fg_g = (fg >> 8) & 0xFF;
-    uint8_t fg_b = fg & 0xFF;
+void graphics_tiles_end(void) {
+    tiles_active = 0;
+}
 
-    uint8_t r = (fg_r * alpha + bg_r * inv_alpha) / 255;
-    uint8_t g = (fg_g * alpha + bg_g * inv_alpha) / 255;
-    uint8_t b = (fg_b * alpha + bg_b * inv_alpha) / 255;
+/* Satır işini dağıt; karo modunda doğrudan çalıştır */
+static void rows_for(int y0, int y1, task_range_fn fn, void *arg) {
+    if(tiles_active) {
+        fn(y0, y1, arg);
+    } else {
+        parallel_for(y0, y1, ROW_GRAIN, fn, arg);
+    }
+}
 
-    return 0xFF000000 | (r << 16) | (g << 8) | b;
+static inline void mark_pixel(int x, int y) {
+    if(tiles_active) return;
+    if(fill_pending) graphics_dma_sync();
+    dirty_tiles[y >> DIRTY_TILE_SHIFT] |= 1u << (x >> DIRTY_TILE_SHIFT);
+}
+
+void graphics_mark_dirty(int x, int y, int w, int h) {
+    if(tiles_active) return;
+    if(x < 0) { w += x; x = 0; }
+    if(y < 0) { h += y; y = 0; }
+    if(x + w > GFX_WIDTH) w = GFX_WIDTH - x;
+    if(y + h > GFX_HEIGHT) h = GFX_HEIGHT - y;
+    if(w <= 0 || h <= 0) return;
+    if(fill_pending) graphics_dma_sync();
+
+    int c0 = x >> DIRTY_TILE_SHIFT;
+    int c1 = (x + w - 1) >> DIRTY_TILE_SHIFT;
+    uint32_t cols = (DIRTY_ALL >> (DIRTY_COLS - 1 - c1)) & ~((1u << c0) - 1);
+
+    for(int r = y >> DIRTY_TILE_SHIFT; r <= (y + h - 1) >> DIRTY_TILE_SHIFT; r++) {
+        dirty_tiles[r] |= cols;
+    }
+}
+
+void graphics_invalidate(void) {
+    dirty_force_full = 1;
+}
+
+/*
+ * Tam genişlikte satırları DMA ile doldur. Bölge önbellek satırına hizalı
+ * olduğundan sadece invalidate yeterli: kirli satırlar boşa geri yazılmaz.
+ * Bitişi bir sonraki işaretleme (yani bir sonraki çizim) bekler.
+ */
+static int dma_fill_rows(int y, int h, uint32_t color) {
+    if(tiles_active || !dma_available() || (uint32_t)h * GFX_WIDTH * FB_BYTES < DMA_FILL_MIN) return -1;
+
+    graphics_mark_dirty(0, y, GFX_WIDTH, h);
+
+    uint8_t *dst = draw_buffer + y * FB_STRIDE;
+    fill_dst = dst;
+    fill_len = h * FB_STRIDE;
+    dcache_invalidate_range(dst, fill_len);
+
+    dma_chain_begin(DMA_CH_FILL);
+    dma_chain_fill_2d(DMA_CH_FILL, dst, FB_STRIDE, fb_fill_word(color), GFX_WIDTH * FB_BYTES, h);
+    dma_chain_submit(DMA_CH_FILL);
+    fill_pending = 1;
+    return 0;
+}
+
+uint32_t graphics_presented_bytes(void) {
+    return presented_bytes;
+}
+
+/* Piksel okuma (alpha blending için) */
+static uint32_t read_pixel(int x, int y) {
+    if(x < 0 || x >= GFX_WIDTH || y < 0 || y >= GFX_HEIGHT) return 0;
+    return fb_argb(*fb_row(x, y));
 }
 
 void draw_pixel(int x, int y, uint32_t color) {
-    if(x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return;
+    if(displist_recording()) {
+        displist_record(DL_PIXEL, x, y, 1, 1, color, 0, 0, 0);
+        return;
+    }
+    if(!clip_point(x, y)) return;
 
     /* Back buffer'a çiz (sabit pitch kullan) */
-    uint32_t offset = (y * SCREEN_WIDTH * 4) + (x * 4);
-    uint32_t *pixel_addr = (uint32_t *)(draw_buffer + offset);
-    *pixel_addr = color;
+    mark_pixel(x, y);
+    *fb_row(x, y) = fb_color(color);
 }
 
 /* Alpha destekli piksel çizimi */
 static void draw_pixel_alpha(int x, int y, uint32_t color, uint8_t alpha) {
-    if(x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) return;
+    if(!clip_point(x, y)) return;
     if(alpha == 0) return;
 
-    uint32_t offset = (y * SCREEN_WIDTH * 4) + (x * 4);
-    uint32_t *pixel_addr = (uint32_t *)(draw_buffer + offset);
+    fb_pixel_t *pixel_addr = fb_row(x, y);
+    mark_pixel(x, y);
 
     if(alpha == 255) {
-        *pixel_addr = color;
+        *pixel_addr = fb_color(color);
     } else {
-        *pixel_addr = blend_colors(*pixel_addr, color, alpha);
+        *pixel_addr = fb_blend_pixel(*pixel_addr, color, alpha);
     }
 }
 
 void draw_rect(int x, int y, int w, int h, uint32_t color) {
+    if(displist_recording()) {
+        displist_record(DL_RECT, x, y, w, h, color, 0, 0, 0);
+        return;
+    }
+
     /* Sınırları kontrol et */
-    if(x < 0) { w += x; x = 0; }
-    if(y < 0) { h += y; y = 0; }
-    if(x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
-    if(y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
-    if(w <= 0 || h <= 0) return;
+    if(!clip_rect(&x, &y, &w, &h)) return;
+    if(x == 0 && w == GFX_WIDTH && dma_fill_rows(y, h, color) == 0) return;
+    graphics_mark_dirty(x, y, w, h);
 
     /* Her satırı tek seferde doldur */
+    fb_pixel_t c = fb_color(color);
     for(int j = y; j < y + h; j++) {
-        uint32_t *row = (uint32_t *)(draw_buffer + (j * SCREEN_WIDTH * 4) + (x * 4));
-        for(int i = 0; i < w; i++) {
-            row[i] = color;
-        }
+        fb_fill(fb_row(x, j), w, c);
     }
 }
 
 /* Alpha destekli dikdörtgen */
 void draw_rect_alpha(int x, int y, int w, int h, uint32_t color, uint8_t alpha) {
+    if(displist_recording()) {
+        displist_record(DL_RECT_ALPHA, x, y, w, h, color, 0, alpha, 0);
+        return;
+    }
     if(alpha == 255) {
         draw_rect(x, y, w, h, color);
         return;
@@ -109,17 +388,11 @@ void draw_rect_alpha(int x, int y, int w, int h, uint32_t color, uint8_t alpha)
     if(alpha == 0) return;
 
     /* Sınırları kontrol et */
-    if(x < 0) { w += x; x = 0; }
-    if(y < 0) { h += y; y = 0; }
-    if(x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
-    if(y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
-    if(w <= 0 || h <= 0) return;
+    if(!clip_rect(&x, &y, &w, &h)) return;
+    graphics_mark_dirty(x, y, w, h);
 
     for(int j = y; j < y + h; j++) {
-        uint32_t *row = (uint32_t *)(draw_buffer + (j * SCREEN_WIDTH * 4) + (x * 4));
-        for(int i = 0; i < w; i++) {
-            row[i] = blend_colors(row[i], color, alpha);
-        }
+        fb_span_blend(fb_row(x, j), w, color, alpha);
     }
 }
 
@@ -130,46 +403,95 @@ void draw_rect_outline(int x, int y, int w, int h, int thickness, uint32_t color
     draw_rect(x + w - thickness, y, thickness, h, color);
 }
 
-void clear_screen(uint32_t color) {
-    uint32_t *buf = (uint32_t *)draw_buffer;
-    uint32_t total = SCREEN_WIDTH * SCREEN_HEIGHT;
+static void clear_rows(int y0, int y1, void *arg) {
+    fb_pixel_t color = fb_color(*(uint32_t *)arg);
 
-    /* Hızlı doldurma */
-    for(uint32_t i = 0; i < total; i++) {
-        buf[i] = color;
+    /* Tam çözünürlükte satırlar bitişik: tek doldurma */
+    if(GFX_WIDTH == SCREEN_WIDTH) {
+        fb_fill(fb_row(0, y0), (y1 - y0) * SCREEN_WIDTH, color);
+        return;
+    }
+    for(int y = y0; y < y1; y++) {
+        fb_fill(fb_row(0, y), GFX_WIDTH, color);
     }
 }
 
-void draw_gradient_bg(uint32_t color_top, uint32_t color_bottom) {
-    int16_t r1 = (color_top >> 16) & 0xFF;
-    int16_t g1 = (color_top >> 8) & 0xFF;
-    int16_t b1 = color_top & 0xFF;
+void clear_screen(uint32_t color) {
+    if(displist_recording()) {
+        displist_record(DL_CLEAR, 0, 0, GFX_WIDTH, GFX_HEIGHT, color, 0, 0, 0);
+        return;
+    }
+    if(!clip_is_full()) {
+        ClipRect *c = cur_clip();
+        draw_rect(c->x0, c->y0, c->x1 - c->x0, c->y1 - c->y0, color);
+        return;
+    }
+    if(dma_fill_rows(0, GFX_HEIGHT, color) == 0) return;
+    graphics_mark_dirty(0, 0, GFX_WIDTH, GFX_HEIGHT);
+    rows_for(0, GFX_HEIGHT, clear_rows, &color);
+}
 
-    int16_t r2 = (color_bottom >> 16) & 0xFF;
-    int16_t g2 = (color_bottom >> 8) & 0xFF;
-    int16_t b2 = color_bottom & 0xFF;
+typedef struct {
+    int16_t r1, g1, b1;
+    int16_t r2, g2, b2;
+    int x, w;
+} GradientJob;
+
+static void gradient_rows(int y0, int y1, void *arg) {
+    GradientJob *job = (GradientJob *)arg;
 
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        int16_t r = r1 + (r2 - r1) * y / SCREEN_HEIGHT;
-        int16_t g = g1 + (g2 - g1) * y / SCREEN_HEIGHT;
-        int16_t b = b1 + (b2 - b1) * y / SCREEN_HEIGHT;
+    for(int y = y0; y < y1; y++) {
+        int16_t r = job->r1 + (job->r2 - job->r1) * y / GFX_HEIGHT;
+        int16_t g = job->g1 + (job->g2 - job->g1) * y / GFX_HEIGHT;
+        int16_t b = job->b1 + (job->b2 - job->b1) * y / GFX_HEIGHT;
         uint32_t color = 0xFF000000 | (r << 16) | (g << 8) | b;
 
-        uint32_t *row = (uint32_t *)(draw_buffer + (y * SCREEN_WIDTH * 4));
-        for(int x = 0; x < SCREEN_WIDTH; x++) {
-            row[x] = color;
-        }
+        gradient_fill(job->x, y, job->w, color);
     }
 }
 
+void draw_gradient_bg(uint32_t color_top, uint32_t color_bottom) {
+    GradientJob job;
+
+    if(displist_recording()) {
+        displist_record(DL_GRADIENT_BG, 0, 0, GFX_WIDTH, GFX_HEIGHT, color_top, color_bottom, 0, 0);
+        return;
+    }
+
+    job.r1 = (color_top >> 16) & 0xFF;
+    job.g1 = (color_top >> 8) & 0xFF;
+    job.b1 = color_top & 0xFF;
+
+    job.r2 = (color_bottom >> 16) & 0xFF;
+    job.g2 = (color_bottom >> 8) & 0xFF;
+    job.b2 = color_bottom & 0xFF;
+
+    /* Renk satırın ekrandaki y'sinden hesaplanır: clip sonucu değiştirmez */
+    ClipRect *c = cur_clip();
+    job.x = c->x0;
+    job.w = c->x1 - c->x0;
+    graphics_mark_dirty(c->x0, c->y0, job.w, c->y1 - c->y0);
+    rows_for(c->y0, c->y1, gradient_rows, &job);
+}
+
 /* Dikdörtgen içinde gradient */
 void draw_gradient_rect(int x, int y, int w, int h, uint32_t color_top, uint32_t color_bottom) {
+    if(displist_recording()) {
+        displist_record(DL_GRADIENT_RECT, x, y, w, h, color_top, color_bottom, 0, 0);
+        return;
+    }
+
+    /* Renk adımı ekrana kırpılmış dikdörtgene göre, clip sadece satır seçer */
     if(x < 0) { w += x; x = 0; }
     if(y < 0) { h += y; y = 0; }
-    if(x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
-    if(y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+    if(x + w > GFX_WIDTH) w = GFX_WIDTH - x;
+    if(y + h > GFX_HEIGHT) h = GFX_HEIGHT - y;
     if(w <= 0 || h <= 0) return;
 
+    int cx = x, cy = y, cw = w, ch = h;
+    if(!clip_rect(&cx, &cy, &cw, &ch)) return;
+    graphics_mark_dirty(cx, cy, cw, ch);
+
     int16_t r1 = (color_top >> 16) & 0xFF;
     int16_t g1 = (color_top >> 8) & 0xFF;
     int16_t b1 = color_top & 0xFF;
@@ -178,101 +500,539 @@ void draw_gradient_rect(int x, int y, int w, int h, uint32_t color_top, uint32_t
     int16_t g2 = (color_bottom >> 8) & 0xFF;
     int16_t b2 = color_bottom & 0xFF;
 
-    for(int j = 0; j < h; j++) {
+    for(int j = cy - y; j < cy - y + ch; j++) {
         int16_t r = r1 + (r2 - r1) * j / h;
         int16_t g = g1 + (g2 - g1) * j / h;
         int16_t b = b1 + (b2 - b1) * j / h;
         uint32_t color = 0xFF000000 | (r << 16) | (g << 8) | b;
 
-        uint32_t *row = (uint32_t *)(draw_buffer + ((y + j) * SCREEN_WIDTH * 4) + (x * 4));
-        for(int i = 0; i < w; i++) {
-            row[i] = color;
-        }
+        gradient_fill(cx, y + j, cw, color);
     }
 }
 
-/* Cam efektli panel - yarı saydam blur benzeri efekt */
-void draw_glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha) {
+/*
+ * Ekran dışı çizim: draw_buffer geçici olarak tam ekran bir ara tampona
+ * çevrilir, çizimler (x, y, w, h) clip'iyle doğrudan yapılır (kayıt,
+ * kirli işaretleme, DMA ve iç parallel_for kapalı); çağıranın clip'i
+ * end'de geri yüklenir. Çekirdek 0'da, karo raster'ı dışında çağrılır;
+ * iç içe kullanılamaz.
+ */
+static uint8_t *offscreen_buffer;
+static uint8_t *offscreen_save;
+static int offscreen_recording;
+static ClipRect offscreen_clip;
+static int off_x, off_y, off_w, off_h;
+
+int graphics_offscreen_begin(int x, int y, int w, int h) {
+    if(!offscreen_buffer) {
+        offscreen_buffer = (uint8_t *)page_alloc((BACK_BUFFER_SIZE + PAGE_SIZE - 1) / PAGE_SIZE);
+        if(!offscreen_buffer) return -1;
+    }
+
     if(x < 0) { w += x; x = 0; }
     if(y < 0) { h += y; y = 0; }
-    if(x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
-    if(y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
-    if(w <= 0 || h <= 0) return;
+    if(x + w > GFX_WIDTH) w = GFX_WIDTH - x;
+    if(y + h > GFX_HEIGHT) h = GFX_HEIGHT - y;
+    if(w <= 0 || h <= 0) return -1;
 
-    uint8_t tint_r = (tint >> 16) & 0xFF;
-    uint8_t tint_g = (tint >> 8) & 0xFF;
-    uint8_t tint_b = tint & 0xFF;
+    off_x = x;
+    off_y = y;
+    off_w = w;
+    off_h = h;
+    offscreen_save = draw_buffer;
+    offscreen_recording = displist_active;
+    displist_active = 0;
+    offscreen_clip = *cur_clip();
+    draw_buffer = offscreen_buffer;
+    graphics_tiles_begin();
+    graphics_set_clip(x, y, w, h);
+    return 0;
+}
 
-    for(int j = y; j < y + h; j++) {
-        uint32_t *row = (uint32_t *)(draw_buffer + (j * SCREEN_WIDTH * 4) + (x * 4));
-        for(int i = 0; i < w; i++) {
-            uint32_t bg = row[i];
-            uint8_t bg_r = (bg >> 16) & 0xFF;
-            uint8_t bg_g = (bg >> 8) & 0xFF;
-            uint8_t bg_b = bg & 0xFF;
-
-            /* Blur simülasyonu: arka plan rengini açıklaştır ve tint uygula */
-            uint8_t light_r = bg_r + (255 - bg_r) / 4;
-            uint8_t light_g = bg_g + (255 - bg_g) / 4;
-            uint8_t light_b = bg_b + (255 - bg_b) / 4;
-
-            /* Tint ile karıştır */
-            uint8_t inv_alpha = 255 - alpha;
-            uint8_t r = (tint_r * alpha + light_r * inv_alpha) / 255;
-            uint8_t g = (tint_g * alpha + light_g * inv_alpha) / 255;
-            uint8_t b = (tint_b * alpha + light_b * inv_alpha) / 255;
-
-            row[i] = 0xFF000000 | (r << 16) | (g << 8) | b;
+void graphics_offscreen_end(Surface *out) {
+    /* Alan, yüzeyin sol üstü (out->w x out->h) başlangıç noktası sayılarak kopyalanır */
+    if(out && out->pixels && out->format == SURFACE_FB) {
+        int w = off_w < out->w ? off_w : out->w;
+        int h = off_h < out->h ? off_h : out->h;
+        for(int j = 0; j < h; j++) {
+            memcpy((uint8_t *)out->pixels + j * out->stride, fb_row(off_x, off_y + j), w * FB_BYTES);
         }
     }
 
+    *cur_clip() = offscreen_clip;
+    graphics_tiles_end();
+    draw_buffer = offscreen_save;
+    displist_active = offscreen_recording;
+}
+
+typedef struct {
+    int x, w;
+    uint32_t tint;
+    uint8_t alpha;
+} GlassJob;
+
+/* Yedek yol (önbellek yoksa): arka planı açıklaştır ve tint uygula */
+static void glass_rows(int y0, int y1, void *arg) {
+    GlassJob *job = (GlassJob *)arg;
+
+    for(int j = y0; j < y1; j++) {
+        fb_span_glass(fb_row(job->x, j), job->w, job->tint, job->alpha);
+    }
+}
+
+/*
+ * Buzlu cam: panelin altındaki alan çeyrek çözünürlüğe indirilir (4x4
+ * ortalama), üç yatay + üç dikey kutu bulanıklığıyla (~Gauss) yumuşatılır,
+ * açıklaştırılıp tint ile karıştırılır ve önbellekte tutulur. Çizimde
+ * önbellek çift doğrusal (bilinear) büyütülüp kopyalanır.
+ *
+ * Dikey geçiş blur_box_cols (NEON, kayan toplam); yatay geçişler aktarma
+ * (transpose) + aynı çekirdek. Displist her cam komutu için altındaki
+ * komutların özetinden bir anahtar çıkarır: anahtar önbellekte varsa
+ * bulanıklık yeniden hesaplanmaz, yoksa alt komutlar ayrı bir tampona
+ * yeniden çizilip yakalanır (graphics_glass_prepare).
+ *
+ * Frame'de kullanılan girişler raster bitene kadar sabitlenir (frame
+ * numarası): sonraki bir prepare onları çıkaramaz. Sabit olmayan giriş
+ * yoksa önbellek GLASS_CACHE_MAX'a kadar büyür; böylece boyutu bir
+ * frame'deki cam sayısını izler.
+ */
+#define GLASS_DOWN          4
+#define GLASS_QW            (SCREEN_WIDTH / GLASS_DOWN)     /* 160 */
+#define GLASS_QH            (SCREEN_HEIGHT / GLASS_DOWN)    /* 120 */
+#define GLASS_BLUR_RADIUS   2       /* Çeyrek piksel; 3 geçişle ~10 piksel yayılma */
+#define GLASS_CACHE_MAX     16      /* Giriş başına 75 KB */
+#define GLASS_QPAGES        ((GLASS_QW * GLASS_QH * 4 + PAGE_SIZE - 1) / PAGE_SIZE)
+
+typedef struct {
+    uint32_t key;                   /* 0 = boş (doğrudan çizim de 0 kullanır) */
+    uint32_t frame;                 /* glass_frame'e eşitse sabit */
+    int qw, qh;
+    uint32_t *pixels;               /* qw x qh, ARGB, tint uygulanmış */
+} GlassCache;
+
+static GlassCache glass_cache[GLASS_CACHE_MAX];
+static int glass_count;             /* Ayrılmış giriş sayısı */
+static int glass_next;
+static uint32_t glass_frame = 1;
+static uint32_t *glass_tmp[2];      /* Bulanıklık ara tamponları (GLASS_QW x GLASS_QH) */
+
+static int glass_alloc(void) {
+    if(glass_tmp[1]) return 0;
+    if(!glass_tmp[0]) glass_tmp[0] = (uint32_t *)page_alloc(GLASS_QPAGES);
+    if(!glass_tmp[0]) return -1;
+    glass_tmp[1] = (uint32_t *)page_alloc(GLASS_QPAGES);
+    return glass_tmp[1] ? 0 : -1;
+}
+
+static GlassCache *glass_find(uint32_t key) {
+    for(int i = 0; i < glass_count; i++) {
+        if(glass_cache[i].key == key) return &glass_cache[i];
+    }
+    return 0;
+}
+
+/* Yakalama için giriş: sabit olmayanlardan sırayla, yoksa yeni giriş */
+static GlassCache *glass_slot(void) {
+    for(int n = 0; n < glass_count; n++) {
+        GlassCache *e = &glass_cache[glass_next];
+        glass_next = (glass_next + 1) % glass_count;
+        if(e->frame != glass_frame) return e;
+    }
+
+    if(glass_count == GLASS_CACHE_MAX) return 0;
+    GlassCache *e = &glass_cache[glass_count];
+    e->pixels = (uint32_t *)page_alloc(GLASS_QPAGES);
+    if(!e->pixels) return 0;
+    e->key = 0;
+    e->frame = 0;
+    glass_count++;
+    return e;
+}
+
+/* Kaynak qw x rows (adım sstride) -> hedef rows x qw (adım dstride) */
+static void glass_transpose(uint32_t *dst, int dstride, const uint32_t *src, int sstride,
+                            int qw, int rows) {
+    for(int j = 0; j < rows; j++) {
+        for(int i = 0; i < qw; i++) {
+            dst[i * dstride + j] = src[j * sstride + i];
+        }
+    }
+}
+
+/* draw_buffer'daki (x, y, w, h) alanını bulanıklaştırıp e'ye yakala */
+static void glass_capture(GlassCache *e, int x, int y, int w, int h,
+                          uint32_t tint, uint8_t alpha) {
+    int qw = (w + GLASS_DOWN - 1) / GLASS_DOWN;
+    int qh = (h + GLASS_DOWN - 1) / GLASS_DOWN;
+    int qw4 = (qw + 3) & ~3;        /* blur_box_cols 4 piksellik sütun bloğu işler */
+    int qh4 = (qh + 3) & ~3;
+    uint32_t *a = glass_tmp[0];
+    uint32_t *b = glass_tmp[1];
+
+    /* 4x4 ortalama; kenardaki eksik bloklar mevcut piksellerden */
+    for(int qj = 0; qj < qh; qj++) {
+        int y0 = y + qj * GLASS_DOWN;
+        int y1 = y0 + GLASS_DOWN > y + h ? y + h : y0 + GLASS_DOWN;
+        for(int qi = 0; qi < qw; qi++) {
+            int x0 = x + qi * GLASS_DOWN;
+            int x1 = x0 + GLASS_DOWN > x + w ? x + w : x0 + GLASS_DOWN;
+            uint32_t rs = 0, gs = 0, bs = 0, n = (x1 - x0) * (y1 - y0);
+            for(int j = y0; j < y1; j++) {
+                const fb_pixel_t *p = fb_row(x0, j);
+                for(int i = 0; i < x1 - x0; i++) {
+                    uint32_t c = fb_argb(p[i]);
+                    rs += (c >> 16) & 0xFF;
+                    gs += (c >> 8) & 0xFF;
+                    bs += c & 0xFF;
+                }
+            }
+            a[qj * qw4 + qi] = 0xFF000000 | ((rs / n) << 16) | ((gs / n) << 8) | (bs / n);
+        }
+        for(int qi = qw; qi < qw4; qi++) {
+            a[qj * qw4 + qi] = 0;
+        }
+    }
+
+    /* Dikey x3, aktar, dikey x3 (= yatay), geri aktar */
+    blur_box_cols(b, a, qw4, qh, GLASS_BLUR_RADIUS);
+    blur_box_cols(a, b, qw4, qh, GLASS_BLUR_RADIUS);
+    blur_box_cols(b, a, qw4, qh, GLASS_BLUR_RADIUS);
+    glass_transpose(a, qh4, b, qw4, qw, qh);
+    for(int qi = 0; qi < qw; qi++) {
+        for(int qj = qh; qj < qh4; qj++) {
+            a[qi * qh4 + qj] = 0;
+        }
+    }
+    blur_box_cols(b, a, qh4, qw, GLASS_BLUR_RADIUS);
+    blur_box_cols(a, b, qh4, qw, GLASS_BLUR_RADIUS);
+    blur_box_cols(b, a, qh4, qw, GLASS_BLUR_RADIUS);
+    glass_transpose(e->pixels, qw, b, qh4, qh, qw);
+
+    /* Açıklaştır ve tint: doğrusal olduğu için büyütmeden önce yapılabilir */
+    blend_span_glass(e->pixels, qw * qh, tint, alpha);
+    e->qw = qw;
+    e->qh = qh;
+}
+
+/* a ile b arası, f/256 */
+static inline uint32_t glass_lerp(uint32_t a, uint32_t b, uint32_t f) {
+    uint32_t rb = ((a & 0xFF00FF) * (256 - f) + (b & 0xFF00FF) * f) >> 8;
+    uint32_t g = ((a & 0x00FF00) * (256 - f) + (b & 0x00FF00) * f) >> 8;
+    return 0xFF000000 | (rb & 0xFF00FF) | (g & 0x00FF00);
+}
+
+/* Çeyrek koordinat (8.8): piksel merkezi (i + 0.5) / 4 - 0.5, kenara kelepçeli */
+static inline int glass_coord(int i, int qn) {
+    int u = i * (256 / GLASS_DOWN) - (256 - 256 / GLASS_DOWN) / 2;
+    if(u < 0) u = 0;
+    if(u > (qn - 1) * 256) u = (qn - 1) * 256;
+    return u;
+}
+
+typedef struct {
+    const GlassCache *e;
+    int px, py;                     /* Panelin sol üstü (önbellek orijini) */
+    int x, w;                       /* Kırpılmış sütunlar */
+} GlassDrawJob;
+
+static void glass_draw_rows(int y0, int y1, void *arg) {
+    GlassDrawJob *job = (GlassDrawJob *)arg;
+    const GlassCache *e = job->e;
+    uint32_t line[64];
+
+    for(int j = y0; j < y1; j++) {
+        int v = glass_coord(j - job->py, e->qh);
+        int r0 = v >> 8;
+        int r1 = r0 + 1 < e->qh ? r0 + 1 : r0;
+        const uint32_t *row0 = e->pixels + r0 * e->qw;
+        const uint32_t *row1 = e->pixels + r1 * e->qw;
+
+        for(int x0 = job->x; x0 < job->x + job->w; x0 += 64) {
+            int n = job->x + job->w - x0 > 64 ? 64 : job->x + job->w - x0;
+            for(int i = 0; i < n; i++) {
+                int u = glass_coord(x0 + i - job->px, e->qw);
+                int c0 = u >> 8;
+                int c1 = c0 + 1 < e->qw ? c0 + 1 : c0;
+                uint32_t top = glass_lerp(row0[c0], row0[c1], u & 0xFF);
+                uint32_t bot = glass_lerp(row1[c0], row1[c1], u & 0xFF);
+                line[i] = glass_lerp(top, bot, v & 0xFF);
+            }
+            fb_span_copy(fb_row(x0, j), line, n);
+        }
+    }
+}
+
+/* Gövde: önbellekten (yoksa yakalayarak) veya yedek yoldan */
+static void glass_body(int x, int y, int w, int h, uint32_t tint, uint8_t alpha, uint32_t key) {
+    int cx = x, cy = y, cw = w, ch = h;
+    if(!clip_rect(&cx, &cy, &cw, &ch)) return;
+    graphics_mark_dirty(cx, cy, cw, ch);
+
+    const GlassCache *e = key ? glass_find(key) : 0;
+    if(!e && key == 0 && !tiles_active && glass_alloc() == 0) {
+        /* Doğrudan çizim: arka plan zaten draw_buffer'da, her çağrıda yakala */
+        GlassCache *d = glass_slot();
+        if(d) {
+            d->key = 0;
+            glass_capture(d, x, y, w, h, tint, alpha);
+            e = d;
+        }
+    }
+
+    if(e) {
+        GlassDrawJob job;
+        job.e = e;
+        job.px = x;
+        job.py = y;
+        job.x = cx;
+        job.w = cw;
+        rows_for(cy, cy + ch, glass_draw_rows, &job);
+    } else {
+        GlassJob job;
+        job.x = cx;
+        job.w = cw;
+        job.tint = tint;
+        job.alpha = alpha;
+        rows_for(cy, cy + ch, glass_rows, &job);
+    }
+}
+
+/* Bulanık arka planlı gövde + üst/sol parlak kenar */
+static void glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha, uint32_t key) {
+    /* Kenar çizgileri ekrana kırpılmış köşede kalır, clip sadece gövdeyi keser */
+    if(x < 0) { w += x; x = 0; }
+    if(y < 0) { h += y; y = 0; }
+    if(x + w > GFX_WIDTH) w = GFX_WIDTH - x;
+    if(y + h > GFX_HEIGHT) h = GFX_HEIGHT - y;
+    if(w <= 0 || h <= 0) return;
+
+    glass_body(x, y, w, h, tint, alpha, key);
+
     /* Üst kenara ince parlak çizgi (cam yansıması) */
-    for(int i = x; i < x + w && i < SCREEN_WIDTH; i++) {
+    for(int i = x; i < x + w && i < GFX_WIDTH; i++) {
         draw_pixel_alpha(i, y, 0xFFFFFFFF, 30);
     }
 
     /* Sol kenara ince parlak çizgi */
-    for(int j = y; j < y + h && j < SCREEN_HEIGHT; j++) {
+    for(int j = y; j < y + h && j < GFX_HEIGHT; j++) {
         draw_pixel_alpha(x, j, 0xFFFFFFFF, 15);
     }
 }
 
-/* Yuvarlak köşeli dikdörtgen */
-void draw_rounded_rect(int x, int y, int w, int h, int radius, uint32_t color) {
-    if(radius <= 0) {
-        draw_rect(x, y, w, h, color);
+/* Cam efektli panel - arkası bulanık, yarı saydam */
+void draw_glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha) {
+    if(displist_recording()) {
+        displist_record(DL_GLASS, x, y, w, h, tint, 0, alpha, 0);
         return;
     }
+    glass_panel(x, y, w, h, tint, alpha, 0);
+}
+
+void graphics_glass_panel(int x, int y, int w, int h, uint32_t tint, uint8_t alpha, uint32_t key) {
+    glass_panel(x, y, w, h, tint, alpha, key);
+}
+
+void graphics_glass_begin_frame(void) {
+    glass_frame++;
+}
+
+int graphics_glass_cached(uint32_t key) {
+    GlassCache *e = glass_find(key);
+    if(!e) return 0;
+    e->frame = glass_frame;
+    return 1;
+}
+
+/*
+ * Önbelleği doldur: replay() panelin altındaki komutları ekran dışı
+ * tampona çizer, sonuç yakalanır. Karo raster'ından önce çağrılır.
+ */
+void graphics_glass_prepare(int x, int y, int w, int h, uint32_t tint, uint8_t alpha,
+                            uint32_t key, void (*replay)(void *arg), void *arg) {
+    if(glass_alloc() < 0) return;
+
+    GlassCache *e = glass_slot();
+    if(!e) return;
+    if(graphics_offscreen_begin(x, y, w, h) < 0) return;
+
+    replay(arg);
+
+    e->key = key;
+    e->frame = glass_frame;
+    glass_capture(e, off_x, off_y, off_w, off_h, tint, alpha);
+
+    graphics_offscreen_end(0);
+}
+
+/*
+ * Yuvarlak köşe maskesi: köşenin her satırı için dış kenardan içeri
+ * kaç pikselin tamamen dışarıda kaldığı (inset) ve sınır pikselinin
+ * kaplama oranı (edge). Çeyrek daire her satırda 4 alt satırda
+ * örneklenir, kenar konumlarının ortalaması alınır; böylece satır
+ * başına tek karıştırılan pikselle kenar yumuşar. Maskeler yarıçapa
+ * göre küçük bir önbellekte tutulur; karolar farklı çekirdeklerde
+ * çizildiği için her çekirdeğin kendi önbelleği var. RR_MAX_RADIUS'tan
+ * büyük yarıçaplarda satırlar çizim sırasında aynı yolla hesaplanır.
+ */
+#define RR_MAX_RADIUS       64
+#define RR_CACHE_SIZE       4
+
+typedef struct {
+    int radius;                     /* 0 = boş */
+    uint8_t inset[RR_MAX_RADIUS];
+    uint8_t edge[RR_MAX_RADIUS];
+} CornerMask;
+
+typedef struct {
+    CornerMask masks[RR_CACHE_SIZE];
+    int next;                       /* Sıradaki değiştirilecek giriş */
+} __attribute__((aligned(64))) CornerCache;
+
+static CornerCache corner_caches[SMP_MAX_CORES];
+
+static uint32_t isqrt(uint32_t v) {
+    uint32_t r = 0;
+    uint32_t bit = 1u << 30;
+
+    while(bit > v) bit >>= 2;
+    while(bit) {
+        if(v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
 
+/* Köşe satırı j: e32 = 1/32 piksel biriminde ortalama kenar uzaklığı */
+static int corner_row_e32(int radius, int j) {
+    /* 1/8 piksel birimi: alt satır merkezleri 1, 3, 5, 7 */
+    int r8 = radius * 8;
+    int e32 = 0;
+
+    for(int s = 0; s < 4; s++) {
+        int dy8 = r8 - j * 8 - (2 * s + 1);
+        e32 += r8 - (int)isqrt((uint32_t)(r8 * r8 - dy8 * dy8));
+    }
+    return e32;
+}
+
+static void corner_mask_build(CornerMask *m, int radius) {
+    for(int j = 0; j < radius; j++) {
+        int e32 = corner_row_e32(radius, j);
+        m->inset[j] = (uint8_t)(e32 >> 5);
+        m->edge[j] = (uint8_t)(255 * (32 - (e32 & 31)) / 32);
+    }
+    m->radius = radius;
+}
+
+static const CornerMask *corner_mask(int radius) {
+    CornerCache *cache = &corner_caches[smp_core_id()];
+
+    for(int i = 0; i < RR_CACHE_SIZE; i++) {
+        if(cache->masks[i].radius == radius) return &cache->masks[i];
+    }
+    CornerMask *m = &cache->masks[cache->next];
+    cache->next = (cache->next + 1) % RR_CACHE_SIZE;
+    corner_mask_build(m, radius);
+    return m;
+}
+
+/* Satırın [x0, x1) aralığını clip'e kırpıp doldur / karıştır */
+static void rr_span(const ClipRect *c, int y, int x0, int x1, uint32_t color, uint8_t alpha) {
+    if(x0 < c->x0) x0 = c->x0;
+    if(x1 > c->x1) x1 = c->x1;
+    if(x1 <= x0) return;
+
+    if(alpha == 255) {
+        fb_fill(fb_row(x0, y), x1 - x0, fb_color(color));
+    } else {
+        fb_span_blend(fb_row(x0, y), x1 - x0, color, alpha);
+    }
+}
+
+/* Kenar pikseli: kaplama * alpha ile karıştır */
+static void rr_edge(const ClipRect *c, int x, int y, uint32_t color, uint32_t alpha) {
+    if(x < c->x0 || x >= c->x1 || alpha == 0) return;
+
+    fb_pixel_t *p = fb_row(x, y);
+    *p = alpha >= 255 ? fb_color(color) : fb_blend_pixel(*p, color, (uint8_t)alpha);
+}
+
+/* Köşe satırını y satırına çiz: in = dışta kalan piksel, edge = kenar kaplaması */
+static void rr_corner_row(const ClipRect *c, int in, uint32_t edge, int y,
+                          int x, int w, uint32_t color, uint8_t alpha) {
+    if(y < c->y0 || y >= c->y1) return;
+
+    uint32_t ea = blend_div255(edge * alpha);
+
+    rr_edge(c, x + in, y, color, ea);
+    rr_span(c, y, x + in + 1, x + w - 1 - in, color, alpha);
+    rr_edge(c, x + w - 1 - in, y, color, ea);
+}
+
+/*
+ * Yuvarlak köşeli dikdörtgen: gövde satırları tek span, köşe satırları
+ * maskeden span + iki yumuşak kenar pikseli. Her piksel bir kez yazılır.
+ */
+static void rounded_fill(int x, int y, int w, int h, int radius, uint32_t color, uint8_t alpha) {
     if(radius > w / 2) radius = w / 2;
     if(radius > h / 2) radius = h / 2;
 
-    /* Ana gövde */
-    draw_rect(x + radius, y, w - 2 * radius, h, color);
-    draw_rect(x, y + radius, radius, h - 2 * radius, color);
-    draw_rect(x + w - radius, y + radius, radius, h - 2 * radius, color);
+    int cx = x, cy = y, cw = w, ch = h;
+    if(!clip_rect(&cx, &cy, &cw, &ch)) return;
+    graphics_mark_dirty(cx, cy, cw, ch);
+
+    const ClipRect *c = cur_clip();
+    const CornerMask *m = radius <= RR_MAX_RADIUS ? corner_mask(radius) : 0;
 
-    /* Köşeler (basit yaklaşım - daire çeyrekleri) */
     for(int j = 0; j < radius; j++) {
-        for(int i = 0; i < radius; i++) {
-            int dx = radius - i - 1;
-            int dy = radius - j - 1;
-            if(dx * dx + dy * dy <= radius * radius) {
-                /* Sol üst */
-                draw_pixel(x + i, y + j, color);
-                /* Sağ üst */
-                draw_pixel(x + w - 1 - i, y + j, color);
-                /* Sol alt */
-                draw_pixel(x + i, y + h - 1 - j, color);
-                /* Sağ alt */
-                draw_pixel(x + w - 1 - i, y + h - 1 - j, color);
-            }
+        int in;
+        uint32_t edge;
+        if(m) {
+            in = m->inset[j];
+            edge = m->edge[j];
+        } else {
+            int e32 = corner_row_e32(radius, j);
+            in = e32 >> 5;
+            edge = 255 * (32 - (e32 & 31)) / 32;
         }
+        rr_corner_row(c, in, edge, y + j, x, w, color, alpha);
+        rr_corner_row(c, in, edge, y + h - 1 - j, x, w, color, alpha);
+    }
+
+    /* Gövde: köşeler arasındaki tam satırlar */
+    int y0 = y + radius, y1 = y + h - radius;
+    if(y0 < cy) y0 = cy;
+    if(y1 > cy + ch) y1 = cy + ch;
+    for(int j = y0; j < y1; j++) {
+        rr_span(c, j, cx, cx + cw, color, alpha);
+    }
+}
+
+/* Yuvarlak köşeli dikdörtgen */
+void draw_rounded_rect(int x, int y, int w, int h, int radius, uint32_t color) {
+    if(displist_recording()) {
+        displist_record(DL_ROUNDED, x, y, w, h, color, 0, radius, 0);
+        return;
+    }
+    if(radius <= 0) {
+        draw_rect(x, y, w, h, color);
+        return;
     }
+    rounded_fill(x, y, w, h, radius, color, 255);
 }
 
 /* Yuvarlak köşeli alpha dikdörtgen */
 void draw_rounded_rect_alpha(int x, int y, int w, int h, int radius, uint32_t color, uint8_t alpha) {
+    if(displist_recording()) {
+        displist_record(DL_ROUNDED_ALPHA, x, y, w, h, color, 0, radius, alpha);
+        return;
+    }
     if(alpha == 255) {
         draw_rounded_rect(x, y, w, h, radius, color);
         return;
@@ -283,32 +1043,189 @@ void draw_rounded_rect_alpha(int x, int y, int w, int h, int radius, uint32_t co
         draw_rect_alpha(x, y, w, h, color, alpha);
         return;
     }
+    rounded_fill(x, y, w, h, radius, color, alpha);
+}
 
-    if(radius > w / 2) radius = w / 2;
-    if(radius > h / 2) radius = h / 2;
+/* Daire: yarıçapı yarı kenar olan yuvarlak kare */
+void draw_circle(int cx, int cy, int radius, uint32_t color) {
+    draw_rounded_rect(cx - radius, cy - radius, radius * 2, radius * 2, radius, color);
+}
 
-    /* Ana gövde */
-    draw_rect_alpha(x + radius, y, w - 2 * radius, h, color, alpha);
-    draw_rect_alpha(x, y + radius, radius, h - 2 * radius, color, alpha);
-    draw_rect_alpha(x + w - radius, y + radius, radius, h - 2 * radius, color, alpha);
+void draw_circle_alpha(int cx, int cy, int radius, uint32_t color, uint8_t alpha) {
+    draw_rounded_rect_alpha(cx - radius, cy - radius, radius * 2, radius * 2, radius, color, alpha);
+}
 
-    /* Köşeler */
-    for(int j = 0; j < radius; j++) {
-        for(int i = 0; i < radius; i++) {
-            int dx = radius - i - 1;
-            int dy = radius - j - 1;
-            if(dx * dx + dy * dy <= radius * radius) {
-                draw_pixel_alpha(x + i, y + j, color, alpha);
-                draw_pixel_alpha(x + w - 1 - i, y + j, color, alpha);
-                draw_pixel_alpha(x + i, y + h - 1 - j, color, alpha);
-                draw_pixel_alpha(x + w - 1 - i, y + h - 1 - j, color, alpha);
-            }
+/*
+ * Gölge ve parlama 9 parçalı (9-slice) dokularla. Efekt bir kez, küçük
+ * bir kanonik dikdörtgen üzerinde katman döngüsüyle benzetilir: her
+ * katman beyaz üzerine kalan ışığı azaltır, sonuç kaplamaya çevrilip
+ * önçarpımlı ARGB dokuya yazılır. Çizimde köşe ve kenar parçaları satır
+ * başına fb_span_over ile, gerilen orta sütun tek alpha ile
+ * fb_span_blend ile karıştırılır: her piksel bir kez. Dokular (tür,
+ * boyut, yoğunluk, renk) anahtarlı, çekirdek başına küçük bir LRU
+ * önbellekte. Boyut sınırı aşılırsa veya dikdörtgen dokudan küçükse
+ * katmanlı çizime dönülür.
+ */
+#define SLICE_MAX_SIZE      24
+#define SLICE_TEX_MAX       (2 * SLICE_MAX_SIZE + 1)
+#define SLICE_CACHE_SIZE    4
+
+typedef enum {
+    SLICE_SHADOW,
+    SLICE_GLOW
+} SliceKind;
+
+typedef struct {
+    int kind, size;                 /* Anahtar: tür, boyut, yoğunluk, renk */
+    uint32_t intensity, color;
+    int tw, th;
+    int l, t;                       /* Sol / üst parça; orta sütun l, orta satır t */
+    uint32_t used;                  /* LRU saati, 0 = boş */
+    uint32_t pixels[SLICE_TEX_MAX * SLICE_TEX_MAX];
+} SliceTex;
+
+typedef struct {
+    SliceTex tex[SLICE_CACHE_SIZE];
+    uint32_t clock;
+} __attribute__((aligned(64))) SliceCache;
+
+static SliceCache slice_caches[SMP_MAX_CORES];
+
+/* Kanonik katman: dokuya düşen kısımda kalan ışık *= (255 - a) / 255 */
+static void slice_layer(SliceTex *s, int u, int v, int w, int h, uint8_t a) {
+    int u1 = u + w, v1 = v + h;
+    if(u < 0) u = 0;
+    if(v < 0) v = 0;
+    if(u1 > s->tw) u1 = s->tw;
+    if(v1 > s->th) v1 = s->th;
+
+    for(int j = v; j < v1; j++) {
+        for(int i = u; i < u1; i++) {
+            uint32_t *p = &s->pixels[j * s->tw + i];
+            *p = blend_div255(*p * (255 - a));
         }
     }
 }
 
+/*
+ * Gölge: kanonik dikdörtgen (blur+2)^2, katman L alt kenarda L satır ve
+ * sağ kenarda L sütun, blur-L+2 kaydırılmış. Doku ekranda (x+2, y+2)'den
+ * başlar; orta sütun ve satır artık sadece tek eksene bağlı.
+ */
+static void slice_build_shadow(SliceTex *s, int blur, uint8_t intensity) {
+    int r0 = blur + 2;
+
+    s->tw = s->th = 2 * blur + 1;
+    s->l = s->t = blur - 1;
+    for(int i = 0; i < s->tw * s->th; i++) s->pixels[i] = 255;
+
+    for(int layer = blur; layer > 0; layer--) {
+        uint8_t a = intensity * layer / blur / 2;
+        int offset = blur - layer + 2;
+        slice_layer(s, offset - 2, r0 - 2, r0, layer, a);
+        slice_layer(s, r0 - 2, offset - 2, layer, r0, a);
+    }
+}
+
+/* Parlama: kanonik 1x1 dikdörtgen, katman L her yöne L büyür */
+static void slice_build_glow(SliceTex *s, int size) {
+    s->tw = s->th = 2 * size + 1;
+    s->l = s->t = size;
+    for(int i = 0; i < s->tw * s->th; i++) s->pixels[i] = 255;
+
+    for(int layer = size; layer > 0; layer--) {
+        uint8_t a = 30 * layer / size;
+        slice_layer(s, size - layer, size - layer, 2 * layer + 1, 2 * layer + 1, a);
+    }
+}
+
+static const SliceTex *slice_get(SliceKind kind, int size, uint32_t intensity, uint32_t color) {
+    SliceCache *cache = &slice_caches[smp_core_id()];
+    SliceTex *victim = &cache->tex[0];
+
+    cache->clock++;
+    for(int i = 0; i < SLICE_CACHE_SIZE; i++) {
+        SliceTex *s = &cache->tex[i];
+        if(s->used && s->kind == (int)kind && s->size == size &&
+           s->intensity == intensity && s->color == color) {
+            s->used = cache->clock;
+            return s;
+        }
+        if(s->used < victim->used) victim = s;
+    }
+
+    if(kind == SLICE_SHADOW) {
+        slice_build_shadow(victim, size, (uint8_t)intensity);
+    } else {
+        slice_build_glow(victim, size);
+    }
+
+    /* Kalan ışık -> kaplama, renkle önçarpımlı */
+    for(int i = 0; i < victim->tw * victim->th; i++) {
+        uint32_t a = 255 - victim->pixels[i];
+        victim->pixels[i] = (a << 24) |
+                            (blend_div255(((color >> 16) & 0xFF) * a) << 16) |
+                            (blend_div255(((color >> 8) & 0xFF) * a) << 8) |
+                            blend_div255((color & 0xFF) * a);
+    }
+    victim->kind = kind;
+    victim->size = size;
+    victim->intensity = intensity;
+    victim->color = color;
+    victim->used = cache->clock;
+    return victim;
+}
+
+/* Doku satırının n pikselini (x, y)'ye, clip'e kırparak */
+static void slice_span(const ClipRect *c, int y, int x, const uint32_t *src, int n) {
+    int x0 = x < c->x0 ? c->x0 : x;
+    int x1 = x + n > c->x1 ? c->x1 : x + n;
+    if(x1 <= x0) return;
+
+    fb_span_over(fb_row(x0, y), src + (x0 - x), x1 - x0);
+}
+
+/* Dokuyu (X, Y, W, H) kutusuna ger: köşeler 1:1, orta sütun/satır tekrarlanır */
+static void slice_draw(const SliceTex *s, int X, int Y, int W, int H) {
+    int r = s->tw - s->l - 1;
+    int b = s->th - s->t - 1;
+
+    int cx = X, cy = Y, cw = W, ch = H;
+    if(!clip_rect(&cx, &cy, &cw, &ch)) return;
+    graphics_mark_dirty(cx, cy, cw, ch);
+
+    const ClipRect *c = cur_clip();
+    for(int j = cy; j < cy + ch; j++) {
+        int dj = j - Y;
+        int tr = dj < s->t ? dj : (dj >= H - b ? s->th - (H - dj) : s->t);
+        const uint32_t *row = s->pixels + tr * s->tw;
+
+        slice_span(c, j, X, row, s->l);
+
+        uint8_t a = row[s->l] >> 24;
+        int m0 = X + s->l, m1 = X + W - r;
+        if(m0 < c->x0) m0 = c->x0;
+        if(m1 > c->x1) m1 = c->x1;
+        if(a && m1 > m0) fb_span_blend(fb_row(m0, j), m1 - m0, s->color, a);
+
+        slice_span(c, j, X + W - r, row + s->l + 1, r);
+    }
+}
+
 /* Gölge efekti */
 void draw_shadow(int x, int y, int w, int h, int blur, uint8_t intensity) {
+    if(displist_recording()) {
+        displist_record(DL_SHADOW, x, y, w, h, 0, 0, blur, intensity);
+        return;
+    }
+    if(blur <= 0) return;
+
+    if(blur <= SLICE_MAX_SIZE && w >= blur + 2 && h >= blur + 2) {
+        const SliceTex *s = slice_get(SLICE_SHADOW, blur, intensity, 0xFF000000);
+        slice_draw(s, x + 2, y + 2, w + blur - 1, h + blur - 1);
+        return;
+    }
+
     /* Basit gölge - blur katmanları ile */
     for(int layer = blur; layer > 0; layer--) {
         uint8_t layer_alpha = intensity * layer / blur / 2;
@@ -320,6 +1237,18 @@ void draw_shadow(int x, int y, int w, int h, int blur, uint8_t intensity) {
 
 /* Parlama efekti */
 void draw_glow(int x, int y, int w, int h, uint32_t color, int size) {
+    if(displist_recording()) {
+        displist_record(DL_GLOW, x, y, w, h, color, 0, size, 0);
+        return;
+    }
+    if(size <= 0) return;
+
+    if(size <= SLICE_MAX_SIZE && w >= 1 && h >= 1) {
+        const SliceTex *s = slice_get(SLICE_GLOW, size, 30, color | 0xFF000000);
+        slice_draw(s, x - size, y - size, w + 2 * size, h + 2 * size);
+        return;
+    }
+
     for(int layer = size; layer > 0; layer--) {
         uint8_t layer_alpha = 30 * layer / size;
         draw_rect_alpha(x - layer, y - layer, w + layer * 2, h + layer * 2, color, layer_alpha);
@@ -328,51 +1257,529 @@ void draw_glow(int x, int y, int w, int h, uint32_t color, int size) {
 
 /* Yatay çizgi */
 void draw_line_h(int x, int y, int w, uint32_t color) {
-    if(y < 0 || y >= SCREEN_HEIGHT) return;
-    if(x < 0) { w += x; x = 0; }
-    if(x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
-    if(w <= 0) return;
-
-    uint32_t *row = (uint32_t *)(draw_buffer + (y * SCREEN_WIDTH * 4) + (x * 4));
-    for(int i = 0; i < w; i++) {
-        row[i] = color;
+    if(displist_recording()) {
+        displist_record(DL_LINE_H, x, y, w, 1, color, 0, 0, 0);
+        return;
     }
+
+    int h = 1;
+    if(!clip_rect(&x, &y, &w, &h)) return;
+    graphics_mark_dirty(x, y, w, 1);
+
+    fb_fill(fb_row(x, y), w, fb_color(color));
 }
 
 /* Dikey çizgi */
 void draw_line_v(int x, int y, int h, uint32_t color) {
-    if(x < 0 || x >= SCREEN_WIDTH) return;
-    if(y < 0) { h += y; y = 0; }
-    if(y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
-    if(h <= 0) return;
+    if(displist_recording()) {
+        displist_record(DL_LINE_V, x, y, 1, h, color, 0, 0, 0);
+        return;
+    }
 
+    int w = 1;
+    if(!clip_rect(&x, &y, &w, &h)) return;
+    graphics_mark_dirty(x, y, 1, h);
+
+    fb_pixel_t c = fb_color(color);
     for(int j = y; j < y + h; j++) {
-        uint32_t *pixel = (uint32_t *)(draw_buffer + (j * SCREEN_WIDTH * 4) + (x * 4));
-        *pixel = color;
+        *fb_row(x, j) = c;
     }
 }
 
-/* Buffer değiştir - back buffer'ı framebuffer'a kopyala */
+/* --- Blit --- */
+
+typedef enum {
+    BLIT_COPY,
+    BLIT_ALPHA,
+    BLIT_KEY,
+    BLIT_NATIVE             /* SURFACE_FB: satır kopyası */
+} BlitMode;
+
+typedef struct {
+    const uint8_t *src;     /* Kırpılmış alanın sol üst kaynak pikseli */
+    int stride;
+    int x, y, w;            /* Kırpılmış hedef */
+    BlitMode mode;
+    uint32_t key;
+} BlitJob;
+
+static void blit_rows(int y0, int y1, void *arg) {
+    BlitJob *job = (BlitJob *)arg;
+
+    for(int j = y0; j < y1; j++) {
+        const uint32_t *src = (const uint32_t *)(job->src + (j - job->y) * job->stride);
+        fb_pixel_t *row = fb_row(job->x, j);
+
+        switch(job->mode) {
+            case BLIT_COPY:  fb_span_copy(row, src, job->w); break;
+            case BLIT_ALPHA: fb_span_over(row, src, job->w); break;
+            case BLIT_KEY:   fb_span_key(row, src, job->w, job->key); break;
+            case BLIT_NATIVE: memcpy(row, src, job->w * FB_BYTES); break;
+        }
+    }
+}
+
+/* Bir kez kırp, kaynağı kırpılan kadar kaydır, satırları dağıt */
+static void blit_surface(const Surface *src, int x, int y, BlitMode mode, uint32_t key) {
+    if(!src || !src->pixels) return;
+
+    /* Tampon biçimindeki yüzey sadece kopyalanabilir */
+    int bpp = 4;
+    if(src->format == SURFACE_FB) {
+        if(mode != BLIT_COPY) return;
+        mode = BLIT_NATIVE;
+        bpp = FB_BYTES;
+    } else if(src->format != SURFACE_ARGB8888) {
+        return;
+    }
+
+    int cx = x, cy = y, cw = src->w, ch = src->h;
+    if(!clip_rect(&cx, &cy, &cw, &ch)) return;
+
+    BlitJob job;
+    job.src = (const uint8_t *)src->pixels + (cy - y) * src->stride + (cx - x) * bpp;
+    job.stride = src->stride;
+    job.x = cx;
+    job.y = cy;
+    job.w = cw;
+    job.mode = mode;
+    job.key = key;
+
+    graphics_mark_dirty(cx, cy, cw, ch);
+    rows_for(cy, cy + ch, blit_rows, &job);
+}
+
+void blit(const Surface *src, int x, int y) {
+    if(displist_recording()) {
+        displist_blit(DL_BLIT, src, x, y, 0);
+        return;
+    }
+    blit_surface(src, x, y, BLIT_COPY, 0);
+}
+
+void blit_alpha(const Surface *src, int x, int y) {
+    if(displist_recording()) {
+        displist_blit(DL_BLIT_ALPHA, src, x, y, 0);
+        return;
+    }
+    blit_surface(src, x, y, BLIT_ALPHA, 0);
+}
+
+void blit_colorkey(const Surface *src, int x, int y, uint32_t key) {
+    if(displist_recording()) {
+        displist_blit(DL_BLIT_KEY, src, x, y, key);
+        return;
+    }
+    blit_surface(src, x, y, BLIT_KEY, key);
+}
+
+/* Kirli karo maskesindeki yatay karo dizilerini sırayla işle */
+typedef void (*tile_span_fn)(int x, int y, int w, int h);
+
+static void for_each_tile_span(const uint32_t *mask, tile_span_fn fn) {
+    for(int r = 0; r < DIRTY_ROWS; r++) {
+        uint32_t bits = mask[r];
+        while(bits) {
+            int c0 = __builtin_ctz(bits);
+            int n = __builtin_ctz(~(bits >> c0));
+            int x = c0 * DIRTY_TILE, y = r * DIRTY_TILE;
+            int w = n * DIRTY_TILE, h = DIRTY_TILE;
+            /* Ölçekli modda kenar karoları aktif alana kırpılır */
+            if(x + w > GFX_WIDTH) w = GFX_WIDTH - x;
+            if(y + h > GFX_HEIGHT) h = GFX_HEIGHT - y;
+            if(w > 0 && h > 0) fn(x, y, w, h);
+            bits &= ~(((1u << n) - 1) << c0);
+        }
+    }
+}
+
+/* Back buffer -> görüntülenen buffer (kopya modu) */
+static void present_copy_span(int x, int y, int w, int h) {
+    for(int j = y; j < y + h; j++) {
+        memcpy(display_buffer + j * screen_pitch + x * FB_BYTES,
+               draw_buffer + j * FB_STRIDE + x * FB_BYTES, w * FB_BYTES);
+    }
+    if(display_cached) {
+        for(int j = y; j < y + h; j++) {
+            dcache_clean_range(display_buffer + j * screen_pitch + x * FB_BYTES, w * FB_BYTES);
+        }
+    }
+    presented_bytes += w * h * FB_BYTES;
+}
+
+/*
+ * İki tamponlu modlarda (sayfa çevirme, DMA sunumu) draw_buffer iki frame
+ * eskidir: önceki frame'de değişip bu frame çizilmeyen alan diğer
+ * tampondan (forward_src) taşınır.
+ */
+static uint8_t *forward_src;
+
+static void copy_forward_span(int x, int y, int w, int h) {
+    for(int j = y; j < y + h; j++) {
+        memcpy(draw_buffer + j * FB_STRIDE + x * FB_BYTES,
+               forward_src + j * FB_STRIDE + x * FB_BYTES, w * FB_BYTES);
+    }
+    presented_bytes += w * h * FB_BYTES;
+}
+
+/* draw_buffer'ı GPU/DMA için belleğe yaz */
+static void clean_span(int x, int y, int w, int h) {
+    if(w == SCREEN_WIDTH) {
+        dcache_clean_range(draw_buffer + y * FB_STRIDE, h * FB_STRIDE);
+    } else {
+        for(int j = y; j < y + h; j++) {
+            dcache_clean_range(draw_buffer + j * FB_STRIDE + x * FB_BYTES, w * FB_BYTES);
+        }
+    }
+}
+
+static void flip_clean_span(int x, int y, int w, int h) {
+    clean_span(x, y, w, h);
+    presented_bytes += w * h * FB_BYTES;
+}
+
+/* Karo dizisini DMA zincirine ekle (2D adım: screen_pitch) */
+static int dma_chain_full = 0;
+
+static void dma_present_span(int x, int y, int w, int h) {
+    clean_span(x, y, w, h);
+    if(dma_chain_copy_2d(DMA_CH_PRESENT, display_buffer + y * screen_pitch + x * FB_BYTES, screen_pitch,
+                         draw_buffer + y * FB_STRIDE + x * FB_BYTES, FB_STRIDE,
+                         w * FB_BYTES, h) < 0) {
+        dma_chain_full = 1;
+    }
+    presented_bytes += w * h * FB_BYTES;
+}
+
+/* Önceki frame'e göre eskimiş karolar ve sunulacak karolar */
+static void swap_prepare_masks(uint32_t *stale, uint32_t *present) {
+    for(int r = 0; r < DIRTY_ROWS; r++) {
+        stale[r] = prev_dirty_tiles[r] & ~dirty_tiles[r];
+        present[r] = dirty_force_full ? DIRTY_ALL : dirty_tiles[r];
+    }
+}
+
+static void swap_finish_masks(void) {
+    for(int r = 0; r < DIRTY_ROWS; r++) {
+        prev_dirty_tiles[r] = dirty_tiles[r];
+        dirty_tiles[r] = 0;
+    }
+    dirty_force_full = 0;
+}
+
+/* DMA ile sunum: kopya arka planda sürerken diğer back buffer'a çizilir */
+static void swap_present_dma(void) {
+    uint32_t stale[DIRTY_ROWS];
+    uint32_t present[DIRTY_ROWS];
+    uint8_t *other = back_buffers[back_index ^ 1];
+
+    swap_prepare_masks(stale, present);
+
+    /* Önceki sunum diğer tamponu okumayı bitirmeli (hem kaynak hem sonraki hedef) */
+    dma_wait(DMA_CH_PRESENT);
+
+    forward_src = other;
+    for_each_tile_span(stale, copy_forward_span);
+
+    dma_chain_full = 0;
+    dma_chain_begin(DMA_CH_PRESENT);
+    for_each_tile_span(present, dma_present_span);
+    if(dma_chain_full) {
+        /* Çok fazla parça: tüm ekranı tek 2D blokla gönder */
+        dma_chain_begin(DMA_CH_PRESENT);
+        clean_span(0, 0, GFX_WIDTH, GFX_HEIGHT);
+        dma_chain_copy_2d(DMA_CH_PRESENT, display_buffer, screen_pitch,
+                          draw_buffer, FB_STRIDE, GFX_WIDTH * FB_BYTES, GFX_HEIGHT);
+    }
+    dma_chain_submit(DMA_CH_PRESENT);
+
+    back_index ^= 1;
+    draw_buffer = other;
+    swap_finish_masks();
+}
+
+/* Buffer değiştir - gizli yarıyı göster veya kirli karoları kopyala */
 void graphics_swap_buffers(void) {
     if(!framebuffer) return;
 
+    uint32_t present[DIRTY_ROWS];
+    presented_bytes = 0;
+
+    /* Sunulacak tampona hâlâ DMA dolgusu yazıyor olabilir */
+    if(fill_pending) graphics_dma_sync();
+
+    if(present_dma) {
+        swap_present_dma();
+        return;
+    }
+
+    if(graphics_page_flip) {
+        uint32_t stale[DIRTY_ROWS];
+
+        /* İki yarı sadece bu frame'in kirli karolarında farklı kalır */
+        swap_prepare_masks(stale, present);
+        for(int r = 0; r < DIRTY_ROWS; r++) {
+            present[r] |= stale[r];
+        }
+        forward_src = display_buffer;
+        for_each_tile_span(stale, copy_forward_span);
+
+        /* GPU önbelleği görmez: değişen karoları belleğe yaz, sonra çevir */
+        for_each_tile_span(present, flip_clean_span);
+
+        int back = front_page ^ 1;
+        if(hw_set_virtual_offset(0, (uint32_t)back * screen_height) == 0) {
+            front_page = back;
+            display_buffer = draw_buffer;
+            draw_buffer = fb_page(back ^ 1);
+            swap_finish_masks();
+            return;
+        }
+
+        /* Firmware reddetti: gizli yarıyı back buffer olarak tutup kopyala */
+        uart_puts("[GFX] Sanal ofset reddedildi, kopya moduna geciliyor\n");
+        graphics_page_flip = 0;
+        dirty_force_full = 1;
+    }
+
+    for(int r = 0; r < DIRTY_ROWS; r++) {
+        present[r] = dirty_force_full ? DIRTY_ALL : dirty_tiles[r];
+        dirty_tiles[r] = 0;
+    }
+    dirty_force_full = 0;
+
     /* Memory barrier before copy */
     __asm__ volatile("dsb sy");
 
-    /* Back buffer'ı framebuffer'a kopyala */
-    /* Pitch farklı olabilir, satır satır kopyala */
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        uint32_t *src = (uint32_t *)(draw_buffer + (y * SCREEN_WIDTH * 4));
-        uint32_t *dst = (uint32_t *)(framebuffer + (y * screen_pitch));
-        fast_memcpy32(dst, src, SCREEN_WIDTH);
-    }
+    /* Kirli karoları framebuffer'a kopyala (pitch farklı olabilir, satır satır) */
+    for_each_tile_span(present, present_copy_span);
 
     /* Memory barrier after copy */
     __asm__ volatile("dsb sy");
 }
 
-/* Grafik sistemi başlatıldığında çağrılacak */
-void graphics_init_buffers(void) {
-    draw_buffer = back_buffer_data;
+/* --- Palet (FB8) --- */
+
+#ifdef CONFIG_FB8
+uint32_t fb_palette[256];
+uint8_t fb_palette_map[4096];
+
+static uint32_t pal_theme_set;      /* Yazılmış tema yuvaları (bit maskesi) */
+static uint32_t pal_fade_color;     /* graphics_palette_blend hedefi */
+static uint8_t pal_fade_alpha;
+
+static uint32_t pal_dist(uint32_t a, uint32_t b) {
+    int dr = (int)((a >> 16) & 0xFF) - (int)((b >> 16) & 0xFF);
+    int dg = (int)((a >> 8) & 0xFF) - (int)((b >> 8) & 0xFF);
+    int db = (int)(a & 0xFF) - (int)(b & 0xFF);
+    return dr * dr * 3 + dg * dg * 4 + db * db * 2;     /* Kaba algı ağırlığı */
+}
+
+/*
+ * RGB444 hücresi -> indeks: küp ve gri için en yakın giriş doğrudan
+ * hesaplanır, sonra yazılmış tema yuvaları taranır. Tema renginin kendi
+ * hücresi her zaman kendi yuvasına gider (birebir renk).
+ */
+static void palette_build_map(void) {
+    for(int cell = 0; cell < 4096; cell++) {
+        uint32_t r = ((cell >> 8) & 0xF) * 17;
+        uint32_t g = ((cell >> 4) & 0xF) * 17;
+        uint32_t b = (cell & 0xF) * 17;
+        uint32_t c = (r << 16) | (g << 8) | b;
+
+        int best = PAL_CUBE_FIRST + ((r + 25) / 51) * 36 + ((g + 25) / 51) * 6 + (b + 25) / 51;
+        uint32_t best_d = pal_dist(c, fb_palette[best]);
+
+        int gray = (r + g + b + 22) / 45 - 1;     /* Gri i = 15 * (i + 1) */
+        if(gray < 0) gray = 0;
+        if(gray >= PAL_GRAY_COUNT) gray = PAL_GRAY_COUNT - 1;
+        uint32_t d = pal_dist(c, fb_palette[PAL_GRAY_FIRST + gray]);
+        if(d < best_d) {
+            best = PAL_GRAY_FIRST + gray;
+            best_d = d;
+        }
+
+        for(int i = 0; i < PAL_THEME_COUNT; i++) {
+            if(!(pal_theme_set & (1u << i))) continue;
+            d = pal_dist(c, fb_palette[PAL_THEME_FIRST + i]);
+            if(d < best_d) {
+                best = PAL_THEME_FIRST + i;
+                best_d = d;
+            }
+        }
+        fb_palette_map[cell] = (uint8_t)best;
+    }
+
+    for(int i = 0; i < PAL_THEME_COUNT; i++) {
+        if(!(pal_theme_set & (1u << i))) continue;
+        uint32_t c = fb_palette[PAL_THEME_FIRST + i];
+        fb_palette_map[((c >> 12) & 0xF00) | ((c >> 8) & 0xF0) | ((c >> 4) & 0xF)] = PAL_THEME_FIRST + i;
+    }
+}
+
+/* Ekrandaki palet: çizim paleti, varsa karışım hedefine doğru */
+static void palette_upload(int first, int count) {
+    uint32_t shown[256];
+
+    for(int i = 0; i < count; i++) {
+        uint32_t c = fb_palette[first + i];
+        shown[i] = pal_fade_alpha ? blend_pixel(c, pal_fade_color, pal_fade_alpha) : c;
+    }
+    if(hw_set_palette(first, count, shown) < 0) {
+        uart_puts("[GFX] Palet yazilamadi\n");
+    }
+}
+
+static void palette_init(void) {
+    for(int i = 0; i < 216; i++) {
+        uint32_t r = (i / 36) * 51;
+        uint32_t g = ((i / 6) % 6) * 51;
+        uint32_t b = (i % 6) * 51;
+        fb_palette[PAL_CUBE_FIRST + i] = 0xFF000000 | (r << 16) | (g << 8) | b;
+    }
+    for(int i = 0; i < PAL_GRAY_COUNT; i++) {
+        uint32_t v = (i + 1) * 255 / (PAL_GRAY_COUNT + 1);
+        fb_palette[PAL_GRAY_FIRST + i] = 0xFF000000 | (v << 16) | (v << 8) | v;
+    }
+    for(int i = 0; i < PAL_THEME_COUNT; i++) {
+        fb_palette[PAL_THEME_FIRST + i] = 0xFF000000;
+    }
+    pal_theme_set = 0;
+    pal_fade_alpha = 0;
+
+    palette_build_map();
+    palette_upload(0, 256);
+}
+#endif
+
+void graphics_set_palette(int first, int count, const uint32_t *colors) {
+#ifdef CONFIG_FB8
+    if(first < 0 || count <= 0 || first + count > 256) return;
+
+    for(int i = 0; i < count; i++) {
+        int idx = first + i;
+        fb_palette[idx] = colors[i] | 0xFF000000;
+        if(idx >= PAL_THEME_FIRST) pal_theme_set |= 1u << (idx - PAL_THEME_FIRST);
+    }
+    palette_build_map();
+    palette_upload(first, count);
+
+    /* Aynı renk artık başka indekse düşebilir: liste tamamen yeniden çizsin */
+    displist_invalidate();
+#else
+    (void)first;
+    (void)count;
+    (void)colors;
+#endif
+}
+
+/*
+ * Solma / renk kayması: sadece GPU paletine yazılır (256 giriş), tampon
+ * ve çizim paleti değişmez. 8 bpp dışında -1: çağıran tam ekran
+ * karıştırmaya düşer.
+ */
+int graphics_palette_blend(uint32_t color, uint8_t alpha) {
+#ifdef CONFIG_FB8
+    if(pal_fade_color == color && pal_fade_alpha == alpha) return 0;
+    pal_fade_color = color;
+    pal_fade_alpha = alpha;
+    palette_upload(0, 256);
+    return 0;
+#else
+    (void)color;
+    (void)alpha;
+    return -1;
+#endif
+}
+
+/* Sunum yolunu seç: sayfa çevirme veya back buffer + kopya */
+static int graphics_setup_buffers(void) {
+    uint32_t pages = (BACK_BUFFER_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    /* Çizim kodu sabit FB_STRIDE adım kullanır: pitch eşleşmeli */
+    if(screen_virtual_height >= 2 * screen_height && screen_pitch == FB_STRIDE &&
+       hw_set_virtual_offset(0, 0) == 0) {
+        front_page = 0;
+        display_buffer = fb_page(0);
+        draw_buffer = fb_page(1);
+        display_cached = 1;
+        present_dma = 0;
+        graphics_page_flip = 1;
+        dirty_force_full = 1;
+        uart_puts("[GFX] Sayfa cevirme aktif (");
+        uart_dec(screen_width); uart_puts("x"); uart_dec(screen_virtual_height);
+        uart_puts(" sanal framebuffer)\n");
+        return 0;
+    }
+
+    /* Ölçek değişiminde tamponlar yeniden kullanılır (en büyük boyutta) */
+    if(!back_buffers[0]) {
+        back_buffers[0] = (uint8_t *)page_alloc(pages);
+        back_buffers[1] = dma_available() ? (uint8_t *)page_alloc(pages) : 0;
+    }
+    back_index = 0;
+    draw_buffer = back_buffers[0];
     display_buffer = framebuffer;
+    /* hw_fb_setup() sadece tek yükseklikte framebuffer'ı önbelleksiz yapar */
+    display_cached = screen_virtual_height >= 2 * screen_height;
+    graphics_page_flip = 0;
+    dirty_force_full = 1;
+
+    /* DMA doğrudan belleğe yazar: önbellekli framebuffer'da CPU kopyası kalır */
+    present_dma = back_buffers[1] && !display_cached;
+    if(present_dma) {
+        uart_puts("[GFX] Kopya modu, DMA ile sunum (iki back buffer)\n");
+    } else {
+        uart_puts("[GFX] Kopya modu (back buffer -> framebuffer)\n");
+    }
+    return draw_buffer ? 0 : -1;
+}
+
+/* Grafik sistemi başlatıldığında çağrılacak */
+int graphics_init_buffers(void) {
+#ifdef CONFIG_FB8
+    palette_init();
+#endif
+    return graphics_setup_buffers();
+}
+
+/*
+ * Çizim çözünürlüğünü SCREEN_WIDTH/div x SCREEN_HEIGHT/div yap (1 = tam).
+ * Framebuffer küçük fiziksel boyutla yeniden ayrılır, GPU onu HDMI
+ * moduna ölçekler: doldurma, karıştırma ve sunum div*div kat azalır.
+ * Tamponların satır adımı değişmez; çizim sadece sol üst alanda kalır.
+ * Kare dışında çağrılmalı: yeniden eşleme sırasında (mmu_map_range)
+ * diğer çekirdekler framebuffer'a dokunmamalı.
+ */
+int graphics_set_scale(int div) {
+    if(div < 1 || SCREEN_WIDTH % div || SCREEN_HEIGHT % div) return -1;
+    if(GFX_WIDTH == SCREEN_WIDTH / div && GFX_HEIGHT == SCREEN_HEIGHT / div) return 0;
+
+    /* Eski framebuffer'a süren aktarımlar bitmeli */
+    if(fill_pending) graphics_dma_sync();
+    if(present_dma) dma_wait(DMA_CH_PRESENT);
+
+    uint32_t old_w = screen_width, old_h = screen_height;
+    if(hw_fb_setup(SCREEN_WIDTH / div, SCREEN_HEIGHT / div) < 0) {
+        uart_puts("[GFX] Olcek reddedildi\n");
+        hw_fb_setup(old_w, old_h);
+        graphics_setup_buffers();
+        return -1;
+    }
+    if(graphics_setup_buffers() < 0) return -1;
+
+#ifdef CONFIG_FB8
+    /* Yeni framebuffer'la GPU paleti varsayılana dönmüş olabilir */
+    palette_upload(0, 256);
+#endif
+
+    for(int i = 0; i < SMP_MAX_CORES; i++) {
+        clips[i] = (ClipRect){ .x1 = GFX_WIDTH, .y1 = GFX_HEIGHT };
+    }
+    for(int r = 0; r < DIRTY_ROWS; r++) {
+        dirty_tiles[r] = 0;
+        prev_dirty_tiles[r] = 0;
+    }
+    displist_invalidate();
+    return 0;
 }
@@ -1,6 +1,10 @@
 /* hw.c - Donanım fonksiyonları */
 #include <hw.h>
 #include <graphics.h>
+#include <mmu.h>
+#include <irq.h>
+#include <smp.h>
+#include <drivers/timer.h>
 
 /* Donanım adresleri */
 #define MMIO_BASE       0x3F000000
@@ -15,8 +19,21 @@
 #define UART0_FBRD      ((volatile uint32_t*)(MMIO_BASE + 0x00201028))
 #define UART0_LCRH      ((volatile uint32_t*)(MMIO_BASE + 0x0020102C))
 #define UART0_CR        ((volatile uint32_t*)(MMIO_BASE + 0x00201030))
+#define UART0_IFLS      ((volatile uint32_t*)(MMIO_BASE + 0x00201034))
+#define UART0_IMSC      ((volatile uint32_t*)(MMIO_BASE + 0x00201038))
+#define UART0_MIS       ((volatile uint32_t*)(MMIO_BASE + 0x00201040))
 #define UART0_ICR       ((volatile uint32_t*)(MMIO_BASE + 0x00201044))
 
+/* UART0 bayrak ve kesme bitleri (PL011) */
+#define UART_FR_RXFE    (1 << 4)    /* RX FIFO boş */
+#define UART_FR_TXFF    (1 << 5)    /* TX FIFO dolu */
+#define UART_INT_RX     (1 << 4)    /* RX FIFO seviyesi */
+#define UART_INT_TX     (1 << 5)    /* TX FIFO seviyesi */
+#define UART_INT_RT     (1 << 6)    /* RX zaman aşımı (FIFO'da kalan baytlar) */
+#define UART_INT_ERR    (0xF << 7)  /* Çerçeve/parite/break/taşma */
+#define UART_IFLS_TX_1_8    (0 << 0)
+#define UART_IFLS_RX_1_2    (2 << 3)
+
 /* Mailbox */
 #define MAILBOX_BASE    (MMIO_BASE + 0xB880)
 #define MBOX_READ       ((volatile uint32_t*)(MAILBOX_BASE + 0x00))
@@ -28,7 +45,9 @@
 #define MBOX_REQUEST    0x00000000
 #define MBOX_CH_PROP    8
 
-volatile uint32_t __attribute__((aligned(16))) mbox[36];
+/* Önbellek satırı (64B) hizalı ve katı: GPU ile paylaşılan satırda başka veri olmasın */
+/* 256 girişlik palet (0x4800B) tek mesaja sığar */
+volatile uint32_t __attribute__((aligned(64))) mbox[272];
 
 void delay(int32_t count) {
     __asm__ volatile("__delay_%=: subs %[count], %[count], #1; bne __delay_%=\n"
@@ -43,9 +62,124 @@ void wait_seconds(int seconds) {
     }
 }
 
-static void uart_send(char c) {
-    while(*UART0_FR & (1<<5)) { }
-    *UART0_DR = c;
+/*
+ * Kesme modu (uart_irq_init sonrası): uart_puts baytları TX halkasına
+ * koyup hemen döner, FIFO boşaldıkça kesme halkadan doldurur. Gelen
+ * baytlar zaman damgasıyla RX halkasına alınır. Halkalar çekirdekler
+ * arası tx_lock, aynı çekirdekteki kesmeye karşı irq_save ile korunur.
+ */
+static volatile char uart_tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t uart_tx_head = 0;
+static volatile uint32_t uart_tx_tail = 0;
+static Spinlock uart_tx_lock;
+
+static volatile UartRxEvent uart_rx_buf[UART_RX_BUF_SIZE];
+static volatile uint32_t uart_rx_head = 0;     /* Kesme yazar */
+static volatile uint32_t uart_rx_tail = 0;     /* Okuyan yazar */
+static volatile uint32_t uart_rx_dropped = 0;
+
+static volatile int uart_irq_mode = 0;
+
+/* Halkadan FIFO'ya sığdığı kadar aktar (kilit ve kesme maskesi çağıranda) */
+static void uart_tx_fill(void) {
+    while(uart_tx_tail != uart_tx_head && !(*UART0_FR & UART_FR_TXFF)) {
+        *UART0_DR = uart_tx_buf[uart_tx_tail & (UART_TX_BUF_SIZE - 1)];
+        uart_tx_tail++;
+    }
+    if(uart_tx_tail == uart_tx_head) {
+        *UART0_IMSC &= ~UART_INT_TX;
+    }
+}
+
+static void uart_write(const char *s) {
+    if(!uart_irq_mode) {
+        while(*s) {
+            while(*UART0_FR & UART_FR_TXFF) { }
+            *UART0_DR = *s++;
+        }
+        return;
+    }
+
+    uint64_t flags = irq_save();
+    spin_lock(&uart_tx_lock);
+
+    while(*s) {
+        /* Halka dolu: FIFO'yu elle besle (kesmeler maskeliyken de ilerler) */
+        while(uart_tx_head - uart_tx_tail >= UART_TX_BUF_SIZE) {
+            uart_tx_fill();
+        }
+        uart_tx_buf[uart_tx_head & (UART_TX_BUF_SIZE - 1)] = *s++;
+        uart_tx_head++;
+    }
+
+    /* FIFO'ya yazmak TX kesmesini seviyenin üstüne çıkarır, boşalınca gelir */
+    uart_tx_fill();
+    if(uart_tx_tail != uart_tx_head) {
+        *UART0_IMSC |= UART_INT_TX;
+    }
+
+    spin_unlock(&uart_tx_lock);
+    irq_restore(flags);
+}
+
+static void uart_irq(int irq, void *arg) {
+    (void)irq;
+    (void)arg;
+    uint32_t mis = *UART0_MIS;
+
+    if(mis & (UART_INT_RX | UART_INT_RT | UART_INT_ERR)) {
+        uint32_t now = (uint32_t)timer_get_ticks();
+        while(!(*UART0_FR & UART_FR_RXFE)) {
+            uint8_t c = (uint8_t)(*UART0_DR & 0xFF);
+            uint32_t head = uart_rx_head;
+            if(head - uart_rx_tail >= UART_RX_BUF_SIZE) {
+                uart_rx_dropped++;
+                continue;
+            }
+            uart_rx_buf[head & (UART_RX_BUF_SIZE - 1)].time = now;
+            uart_rx_buf[head & (UART_RX_BUF_SIZE - 1)].c = c;
+            __asm__ volatile("dmb ish" : : : "memory");
+            uart_rx_head = head + 1;
+        }
+        *UART0_ICR = UART_INT_RX | UART_INT_RT | UART_INT_ERR;
+    }
+
+    if(mis & UART_INT_TX) {
+        spin_lock(&uart_tx_lock);
+        uart_tx_fill();
+        spin_unlock(&uart_tx_lock);
+        *UART0_ICR = UART_INT_TX;
+    }
+}
+
+/* FIFO ve kesme modunu aç (irq_init ve timer_init sonrası) */
+void uart_irq_init(void) {
+    uart_tx_lock.locked = 0;
+    uart_tx_head = uart_tx_tail = 0;
+    uart_rx_head = uart_rx_tail = 0;
+    uart_rx_dropped = 0;
+
+    /* TX: FIFO 1/8'e inince doldur, RX: yarı dolunca veya zaman aşımında al */
+    *UART0_IFLS = UART_IFLS_TX_1_8 | UART_IFLS_RX_1_2;
+    *UART0_ICR = 0x7FF;
+
+    irq_register(IRQ_UART0, uart_irq, 0);
+    uart_irq_mode = 1;
+    *UART0_IMSC = UART_INT_RX | UART_INT_RT | UART_INT_ERR;
+    irq_enable(IRQ_UART0);
+}
+
+/* Panik yolu: halkayı yoklamalı olarak boşalt ve kesme modundan çık */
+void uart_sync(void) {
+    if(!uart_irq_mode) return;
+
+    *UART0_IMSC = 0;
+    uart_irq_mode = 0;
+    while(uart_tx_tail != uart_tx_head) {
+        while(*UART0_FR & UART_FR_TXFF) { }
+        *UART0_DR = uart_tx_buf[uart_tx_tail & (UART_TX_BUF_SIZE - 1)];
+        uart_tx_tail++;
+    }
 }
 
 void uart_init(void) {
@@ -68,33 +202,84 @@ void uart_init(void) {
 }
 
 void uart_puts(char *s) {
-    while(*s) { uart_send(*s++); }
+    uart_write(s);
 }
 
 void uart_hex(unsigned int d) {
+    char buf[9];
     unsigned int n;
-    int c;
+    int c, i = 0;
     for(c=28;c>=0;c-=4) {
         n=(d>>c)&0xF;
         n+=n>9?0x37:0x30;
-        uart_send(n);
+        buf[i++] = (char)n;
+    }
+    buf[i] = 0;
+    uart_write(buf);
+}
+
+void uart_dec(unsigned int d) {
+    char buf[11];
+    int i = 10;
+    buf[i] = 0;
+    do {
+        buf[--i] = '0' + (d % 10);
+        d /= 10;
+    } while(d);
+    uart_puts(&buf[i]);
+}
+
+/* Sıradaki index'inci gelen baytı çıkarmadan oku (1 = var) */
+int uart_rx_peek(int index, UartRxEvent *ev) {
+    if(!uart_irq_mode) {
+        /* Yoklamalı mod: FIFO'daki baytı halkaya al, okuma yolu aynı kalsın */
+        uint32_t head = uart_rx_head;
+        if(head - uart_rx_tail <= (uint32_t)index && !(*UART0_FR & UART_FR_RXFE)) {
+            uart_rx_buf[head & (UART_RX_BUF_SIZE - 1)].time = (uint32_t)timer_get_ticks();
+            uart_rx_buf[head & (UART_RX_BUF_SIZE - 1)].c = (uint8_t)(*UART0_DR & 0xFF);
+            uart_rx_head = head + 1;
+        }
     }
+
+    uint32_t tail = uart_rx_tail;
+    if(uart_rx_head - tail <= (uint32_t)index) return 0;
+    __asm__ volatile("dmb ish" : : : "memory");
+    ev->time = uart_rx_buf[(tail + index) & (UART_RX_BUF_SIZE - 1)].time;
+    ev->c = uart_rx_buf[(tail + index) & (UART_RX_BUF_SIZE - 1)].c;
+    return 1;
+}
+
+/* Baştaki count baytı halkadan çıkar */
+void uart_rx_drop(int count) {
+    uint32_t queued = uart_rx_head - uart_rx_tail;
+    if((uint32_t)count > queued) count = (int)queued;
+    uart_rx_tail += count;
+}
+
+/* Halka taşması yüzünden kaybolan bayt sayısı */
+uint32_t uart_rx_dropped_count(void) {
+    return uart_rx_dropped;
 }
 
 /* UART'tan karakter oku (non-blocking) */
 int uart_getc(void) {
-    if(*UART0_FR & (1<<4)) {  /* RXFE - Receive FIFO Empty */
+    UartRxEvent ev;
+    if(!uart_rx_peek(0, &ev)) {
         return -1;  /* Karakter yok */
     }
-    return (int)(*UART0_DR & 0xFF);
+    uart_rx_drop(1);
+    return ev.c;
 }
 
 /* UART'ta karakter var mı? */
 int uart_available(void) {
-    return !(*UART0_FR & (1<<4));
+    UartRxEvent ev;
+    return uart_rx_peek(0, &ev);
 }
 
 static int mailbox_call(unsigned char ch) {
+    /* GPU önbelleği görmez: isteği belleğe yaz */
+    dcache_clean_range((const void *)mbox, sizeof(mbox));
     __asm__ volatile("dsb sy");
 
     uint32_t r = (((uint32_t)((unsigned long)&mbox) & ~0xF) | (ch & 0xF));
@@ -105,40 +290,118 @@ static int mailbox_call(unsigned char ch) {
 
     while(1) {
         while(*MBOX_STATUS & MBOX_EMPTY) { __asm__ volatile("nop"); }
-        if(r == *MBOX_READ) return mbox[1] == 0x80000000;
+        if(r == *MBOX_READ) {
+            /* GPU'nun yazdığı cevabı önbellekten değil bellekten oku */
+            dcache_invalidate_range((const void *)mbox, sizeof(mbox));
+            return mbox[1] == 0x80000000;
+        }
     }
     return 0;
 }
 
-void init_screen(void) {
-    uart_puts("Ekran baslatiliyor...\n");
+/* Görüntülenen bölgeyi sanal framebuffer içinde kaydır (sayfa çevirme) */
+int hw_set_virtual_offset(uint32_t x, uint32_t y) {
+    mbox[0] = 8 * 4;
+    mbox[1] = MBOX_REQUEST;
+    mbox[2] = 0x48009; mbox[3] = 8; mbox[4] = 0; mbox[5] = x; mbox[6] = y;
+    mbox[7] = 0;
+
+    if(!mailbox_call(MBOX_CH_PROP)) return -1;
+
+    /* Firmware sınır dışı ofseti kırpar: istenen değer dönmeli */
+    return (mbox[5] == x && mbox[6] == y) ? 0 : -1;
+}
+
+/* 8 bpp palet girişlerini yaz (firmware sırası 0xAABBGGRR) */
+int hw_set_palette(int first, int count, const uint32_t *colors) {
+    if(first < 0 || count <= 0 || first + count > 256) return -1;
+
+    mbox[0] = (8 + count) * 4;
+    mbox[1] = MBOX_REQUEST;
+    mbox[2] = 0x4800B; mbox[3] = (2 + count) * 4; mbox[4] = 0;
+    mbox[5] = first; mbox[6] = count;
+    for(int i = 0; i < count; i++) {
+        uint32_t c = colors[i];
+        mbox[7 + i] = 0xFF000000 | ((c & 0xFF) << 16) | (c & 0xFF00) | ((c >> 16) & 0xFF);
+    }
+    mbox[7 + count] = 0;
+
+    if(!mailbox_call(MBOX_CH_PROP)) return -1;
+
+    /* Yanıtta ilk kelime 0 = geçerli */
+    return mbox[5] == 0 ? 0 : -1;
+}
+
+/* ARM'a ayrılan bellek (GPU bölünmesinin altı) */
+int hw_get_arm_memory(uint32_t *base, uint32_t *size) {
+    mbox[0] = 8 * 4;
+    mbox[1] = MBOX_REQUEST;
+    mbox[2] = 0x10005; mbox[3] = 8; mbox[4] = 0; mbox[5] = 0; mbox[6] = 0;
+    mbox[7] = 0;
+
+    if(!mailbox_call(MBOX_CH_PROP)) return -1;
+
+    *base = mbox[5];
+    *size = mbox[6];
+    return 0;
+}
 
+/*
+ * Framebuffer'ı (yeniden) ayır. Fiziksel boyut width x height: GPU bu
+ * alanı HDMI moduna (config.txt) ölçekler. Sanal genişlik her zaman
+ * SCREEN_WIDTH (satır adımı çizim tamponuyla aynı kalsın), sanal
+ * yükseklik iki ekran: alt/üst yarı arasında sayfa çevirme.
+ */
+int hw_fb_setup(uint32_t width, uint32_t height) {
     mbox[0] = 35 * 4;
     mbox[1] = MBOX_REQUEST;
 
-    mbox[2] = 0x48003; mbox[3] = 8; mbox[4] = 0; mbox[5] = 640; mbox[6] = 480;
-    mbox[7] = 0x48004; mbox[8] = 8; mbox[9] = 0; mbox[10] = 640; mbox[11] = 480;
+    mbox[2] = 0x48003; mbox[3] = 8; mbox[4] = 0; mbox[5] = width; mbox[6] = height;
+    mbox[7] = 0x48004; mbox[8] = 8; mbox[9] = 0; mbox[10] = SCREEN_WIDTH; mbox[11] = 2 * height;
     mbox[12] = 0x48009; mbox[13] = 8; mbox[14] = 0; mbox[15] = 0; mbox[16] = 0;
-    mbox[17] = 0x48005; mbox[18] = 4; mbox[19] = 0; mbox[20] = 32;
+    /* Derinlik: 32 (ARGB8888), FB16=1 ile 16 (RGB565), FB8=1 ile 8 (paletli) */
+    mbox[17] = 0x48005; mbox[18] = 4; mbox[19] = 0; mbox[20] = FB_BPP;
     mbox[21] = 0x48006; mbox[22] = 4; mbox[23] = 0; mbox[24] = 1;
     mbox[25] = 0x40001; mbox[26] = 8; mbox[27] = 0; mbox[28] = 4096; mbox[29] = 0;
     mbox[30] = 0x40008; mbox[31] = 4; mbox[32] = 0; mbox[33] = 0;
     mbox[34] = 0;
 
-    if(mailbox_call(MBOX_CH_PROP) && mbox[28] != 0) {
-        screen_width = mbox[10];
-        screen_height = mbox[11];
-        screen_pitch = mbox[33];
+    if(!mailbox_call(MBOX_CH_PROP) || mbox[28] == 0) return -1;
+
+    screen_width = mbox[5];
+    screen_height = mbox[6];
+    screen_virtual_height = mbox[11];
+    screen_pitch = mbox[33];
+
+    uint32_t raw_addr = mbox[28];
+    framebuffer = (uint8_t*)((unsigned long)(raw_addr & 0x3FFFFFFF));
 
-        uint32_t raw_addr = mbox[28];
-        uart_puts("GPU Adresi: 0x"); uart_hex(raw_addr); uart_puts("\n");
+    /*
+     * Sayfa çevirmede CPU doğrudan gizli yarıya çizer (karıştırma için
+     * okur da): bölge önbellekli kalır, çevirmeden önce temizlenir.
+     * Kopya yolunda framebuffer'a sadece yazılır: önbelleksiz
+     * (write-combining), GPU her yazımı görür.
+     */
+    mmu_map_range((uintptr_t)framebuffer, screen_pitch * screen_virtual_height,
+                  screen_virtual_height < 2 * screen_height ? MMU_ATTR_NORMAL_NC : MMU_ATTR_NORMAL);
 
-        framebuffer = (uint8_t*)((unsigned long)(raw_addr & 0x3FFFFFFF));
+    uart_puts("LFB: 0x"); uart_hex((unsigned int)((unsigned long)framebuffer));
+    uart_puts(" Boyut: "); uart_dec(screen_width);
+    uart_puts("x"); uart_dec(screen_height);
+    uart_puts(" Pitch: 0x"); uart_hex(screen_pitch);
+    uart_puts(" Sanal Y: "); uart_dec(screen_virtual_height);
+    uart_puts(" Derinlik: "); uart_dec(mbox[20]);
+    uart_puts("\n");
+    if(mbox[20] != FB_BPP) {
+        uart_puts("Uyari: istenen derinlik verilmedi, goruntu bozuk olabilir\n");
+    }
+    return 0;
+}
+
+void init_screen(void) {
+    uart_puts("Ekran baslatiliyor...\n");
 
-        uart_puts("LFB: 0x"); uart_hex((unsigned int)((unsigned long)framebuffer));
-        uart_puts(" Pitch: 0x"); uart_hex(screen_pitch);
-        uart_puts("\n");
-    } else {
+    if(hw_fb_setup(SCREEN_WIDTH, SCREEN_HEIGHT) < 0) {
         uart_puts("GPU Hatasi!\n");
     }
 }
@@ -0,0 +1,202 @@
+/* irq.c - İstisna vektörleri ve kesme (IRQ) dağıtımı */
+#include <irq.h>
+#include <hw.h>
+#include <smp.h>
+
+/* BCM2835 çevre birimi kesme denetleyicisi */
+#define MMIO_BASE           0x3F000000
+#define IRQ_BASE            (MMIO_BASE + 0xB200)
+#define IRQ_BASIC_PENDING   ((volatile uint32_t*)(IRQ_BASE + 0x00))
+#define IRQ_PENDING_1       ((volatile uint32_t*)(IRQ_BASE + 0x04))
+#define IRQ_PENDING_2       ((volatile uint32_t*)(IRQ_BASE + 0x08))
+#define IRQ_FIQ_CONTROL     ((volatile uint32_t*)(IRQ_BASE + 0x0C))
+#define IRQ_ENABLE_1        ((volatile uint32_t*)(IRQ_BASE + 0x10))
+#define IRQ_ENABLE_2        ((volatile uint32_t*)(IRQ_BASE + 0x14))
+#define IRQ_ENABLE_BASIC    ((volatile uint32_t*)(IRQ_BASE + 0x18))
+#define IRQ_DISABLE_1       ((volatile uint32_t*)(IRQ_BASE + 0x1C))
+#define IRQ_DISABLE_2       ((volatile uint32_t*)(IRQ_BASE + 0x20))
+#define IRQ_DISABLE_BASIC   ((volatile uint32_t*)(IRQ_BASE + 0x24))
+
+/* BCM2836 ARM local denetleyici */
+#define LOCAL_BASE          0x40000000UL
+#define LOCAL_GPU_ROUTING   ((volatile uint32_t*)(LOCAL_BASE + 0x0C))
+#define LOCAL_TIMER_ROUTING ((volatile uint32_t*)(LOCAL_BASE + 0x24))
+#define LOCAL_TIMER_CTRL    ((volatile uint32_t*)(LOCAL_BASE + 0x34))
+#define LOCAL_TIMER_CLEAR   ((volatile uint32_t*)(LOCAL_BASE + 0x38))
+#define CORE_TIMER_CTRL(c)  ((volatile uint32_t*)(LOCAL_BASE + 0x40 + 4 * (c)))
+#define CORE_MBOX_CTRL(c)   ((volatile uint32_t*)(LOCAL_BASE + 0x50 + 4 * (c)))
+#define CORE_IRQ_SOURCE(c)  ((volatile uint32_t*)(LOCAL_BASE + 0x60 + 4 * (c)))
+#define CORE_MBOX_SET(c, m) ((volatile uint32_t*)(LOCAL_BASE + 0x80 + 16 * (c) + 4 * (m)))
+#define CORE_MBOX_CLR(c, m) ((volatile uint32_t*)(LOCAL_BASE + 0xC0 + 16 * (c) + 4 * (m)))
+
+#define LOCAL_TIMER_ENABLE  (1u << 28)
+#define LOCAL_TIMER_IRQ_EN  (1u << 29)
+#define LOCAL_TIMER_RELOAD  0x0FFFFFFF
+#define LOCAL_TIMER_FLAG    (1u << 31)
+
+#define LOCAL_SRC_GPU       (1u << 8)
+
+typedef struct {
+    irq_handler_fn fn;
+    void *arg;
+} IrqHandler;
+
+static IrqHandler handlers[IRQ_COUNT];
+
+void irq_init(void) {
+    /* Tüm çevre birimi kesmelerini kapat, FIQ kullanılmıyor */
+    *IRQ_DISABLE_1 = 0xFFFFFFFF;
+    *IRQ_DISABLE_2 = 0xFFFFFFFF;
+    *IRQ_DISABLE_BASIC = 0xFFFFFFFF;
+    *IRQ_FIQ_CONTROL = 0;
+
+    /* GPU kesmeleri ve local timer çekirdek 0'a (IRQ) */
+    *LOCAL_GPU_ROUTING = 0;
+    *LOCAL_TIMER_ROUTING = 0;
+
+    for(int i = 0; i < IRQ_COUNT; i++) {
+        handlers[i].fn = 0;
+        handlers[i].arg = 0;
+    }
+
+    irq_enable_cpu();
+}
+
+void irq_register(int irq, irq_handler_fn fn, void *arg) {
+    if(irq < 0 || irq >= IRQ_COUNT) return;
+
+    uint64_t flags = irq_save();
+    handlers[irq].arg = arg;
+    handlers[irq].fn = fn;
+    irq_restore(flags);
+}
+
+void irq_enable(int irq) {
+    int core = smp_core_id();
+
+    if(irq < 0 || irq >= IRQ_COUNT) return;
+
+    if(irq < 32) {
+        *IRQ_ENABLE_1 = 1u << irq;
+    } else if(irq < IRQ_LOCAL_BASE) {
+        *IRQ_ENABLE_2 = 1u << (irq - 32);
+    } else if(irq <= IRQ_CNTV) {
+        *CORE_TIMER_CTRL(core) |= 1u << (irq - IRQ_CNTPS);
+    } else if(irq <= IRQ_MAILBOX3) {
+        *CORE_MBOX_CTRL(core) |= 1u << (irq - IRQ_MAILBOX0);
+    } else if(irq == IRQ_LOCAL_TIMER) {
+        *LOCAL_TIMER_CTRL |= LOCAL_TIMER_IRQ_EN;
+    }
+    /* GPU, PMU, AXI: yönlendirme ile açılır */
+}
+
+void irq_disable(int irq) {
+    int core = smp_core_id();
+
+    if(irq < 0 || irq >= IRQ_COUNT) return;
+
+    if(irq < 32) {
+        *IRQ_DISABLE_1 = 1u << irq;
+    } else if(irq < IRQ_LOCAL_BASE) {
+        *IRQ_DISABLE_2 = 1u << (irq - 32);
+    } else if(irq <= IRQ_CNTV) {
+        *CORE_TIMER_CTRL(core) &= ~(1u << (irq - IRQ_CNTPS));
+    } else if(irq <= IRQ_MAILBOX3) {
+        *CORE_MBOX_CTRL(core) &= ~(1u << (irq - IRQ_MAILBOX0));
+    } else if(irq == IRQ_LOCAL_TIMER) {
+        *LOCAL_TIMER_CTRL &= ~LOCAL_TIMER_IRQ_EN;
+    }
+}
+
+void irq_mailbox_send(int core, int mbox, uint32_t bits) {
+    if(core < 0 || core >= SMP_MAX_CORES || mbox < 0 || mbox > 3) return;
+    __asm__ volatile("dsb ish" : : : "memory");
+    *CORE_MBOX_SET(core, mbox) = bits;
+}
+
+/* Çağıran çekirdeğin mailbox'ını oku ve temizle */
+uint32_t irq_mailbox_clear(int mbox) {
+    int core = smp_core_id();
+    uint32_t bits = *CORE_MBOX_CLR(core, mbox);
+    *CORE_MBOX_CLR(core, mbox) = bits;
+    return bits;
+}
+
+void irq_local_timer_start(uint32_t reload) {
+    *LOCAL_TIMER_CLEAR = LOCAL_TIMER_FLAG | (1u << 30);
+    *LOCAL_TIMER_CTRL = (reload & LOCAL_TIMER_RELOAD) | LOCAL_TIMER_ENABLE |
+                        (*LOCAL_TIMER_CTRL & LOCAL_TIMER_IRQ_EN);
+}
+
+void irq_local_timer_stop(void) {
+    *LOCAL_TIMER_CTRL &= ~LOCAL_TIMER_ENABLE;
+}
+
+void irq_local_timer_ack(void) {
+    *LOCAL_TIMER_CLEAR = LOCAL_TIMER_FLAG;
+}
+
+static void dispatch_one(int irq) {
+    IrqHandler *h = &handlers[irq];
+    if(h->fn) {
+        h->fn(irq, h->arg);
+    } else {
+        /* Sahipsiz kaynak sürekli tetiklenmesin */
+        irq_disable(irq);
+        uart_puts("[IRQ] Islenmeyen kesme: ");
+        uart_hex(irq);
+        uart_puts("\n");
+    }
+}
+
+static void dispatch_bits(uint32_t pending, int base) {
+    while(pending) {
+        int bit = __builtin_ctz(pending);
+        pending &= pending - 1;
+        dispatch_one(base + bit);
+    }
+}
+
+/* start.s irq_entry'den çağrılır (IRQ maskeli) */
+void irq_dispatch(ExceptionFrame *frame) {
+    (void)frame;
+    uint32_t source = *CORE_IRQ_SOURCE(smp_core_id());
+
+    /* Çevre birimi kesmeleri GPU biti üzerinden gelir */
+    if(source & LOCAL_SRC_GPU) {
+        dispatch_bits(*IRQ_PENDING_1 & *IRQ_ENABLE_1, 0);
+        dispatch_bits(*IRQ_PENDING_2 & *IRQ_ENABLE_2, 32);
+    }
+
+    dispatch_bits(source & ~LOCAL_SRC_GPU & 0xFFF, IRQ_LOCAL_BASE);
+}
+
+static const char *exception_names[4] = {
+    "Senkron", "IRQ", "FIQ", "SError"
+};
+
+/* Beklenmeyen istisna: bilgileri yaz ve dur */
+void exception_handler(ExceptionFrame *frame, uint64_t type) {
+    uint64_t esr, far;
+    __asm__ volatile("mrs %0, esr_el1" : "=r"(esr));
+    __asm__ volatile("mrs %0, far_el1" : "=r"(far));
+
+    /* Kesmeler kapalı ve geri dönülmeyecek: TX halkasını yoklamalı boşalt */
+    uart_sync();
+
+    uart_puts("\n[EXC] ");
+    uart_puts((char *)exception_names[type & 3]);
+    uart_puts(" istisna, vektor ");
+    uart_hex((uint32_t)type);
+    uart_puts(" cekirdek ");
+    uart_hex(smp_core_id());
+    uart_puts("\n  ESR: 0x");
+    uart_hex((uint32_t)esr);
+    uart_puts("\n  ELR: 0x");
+    uart_hex((uint32_t)(frame->elr >> 32));
+    uart_hex((uint32_t)frame->elr);
+    uart_puts("\n  FAR: 0x");
+    uart_hex((uint32_t)(far >> 32));
+    uart_hex((uint32_t)far);
+    uart_puts("\n");
+}
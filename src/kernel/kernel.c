@@ -2,9 +2,19 @@
 #include <types.h>
 #include <hw.h>
 #include <graphics.h>
+#include <displist.h>
+#include <mmu.h>
+#include <smp.h>
+#include <irq.h>
+#include <task.h>
+#include <bench.h>
+#include <mm.h>
+#include <prof.h>
+#include <trace.h>
 #include <screens.h>
 #include <drivers/input.h>
 #include <drivers/timer.h>
+#include <drivers/dma.h>
 #include <ui/filemgr.h>
 #include <ui/theme.h>
 #include <ui/animation.h>
@@ -14,7 +24,7 @@
 
 /* Frame rate kontrolü */
 #define TARGET_FPS          30
-#define FRAME_TIME_MS       (1000 / TARGET_FPS)
+#define FRAME_TIME_US       (1000000 / TARGET_FPS)
 
 /* Input işleme (ana menü) */
 static void handle_main_menu_input(void) {
@@ -124,10 +134,45 @@ void kernel_main(void) {
     uart_puts("========================================\n");
     uart_puts("\n");
 
+    /* MMU start.s'te açıldı (mmu_init) */
+    if(mmu_is_enabled()) {
+        uart_puts("[INIT] MMU ve I/D onbellekleri aktif\n");
+    }
+
+    /* Sayfa ayırıcı ve kernel heap */
+    uart_puts("[INIT] Bellek yoneticisi baslatiliyor...\n");
+    mm_init();
+
+    /* Kesme denetleyicileri (kaynaklar kapalı başlar) */
+    uart_puts("[INIT] Kesme sistemi baslatiliyor...\n");
+    irq_init();
+
     /* Timer başlat */
     timer_init();
     clock_init(12, 0, 0);  /* 12:00:00 başlangıç */
 
+    /* UART kesme modu: bundan sonra loglar render'ı bekletmez */
+    uart_irq_init();
+    uart_puts("[INIT] UART kesme modu aktif (4KB TX/RX halkalari)\n");
+
+    /* İkincil çekirdekleri başlat */
+    uart_puts("[INIT] Ikincil cekirdekler baslatiliyor...\n");
+    smp_init();
+
+    /* PMU profilleyici (sadece PROF=1 ile) */
+    prof_init();
+
+    /* İkili iz halkası (sıcak yol logları, boşta UART'a dökülür) */
+    trace_init();
+
+    /* Görev sistemi (boştaki çekirdekler iş çalar) */
+    uart_puts("[INIT] Gorev sistemi baslatiliyor...\n");
+    task_init();
+
+    /* DMA (sunum ve büyük dolgular; yoksa CPU ile devam edilir) */
+    uart_puts("[INIT] DMA baslatiliyor...\n");
+    dma_init();
+
     /* Ekran başlat */
     uart_puts("[INIT] Ekran baslatiliyor...\n");
     init_screen();
@@ -143,7 +188,10 @@ void kernel_main(void) {
 
     /* Çift tamponlama başlat */
     uart_puts("[INIT] Cift tamponlama baslatiliyor...\n");
-    graphics_init_buffers();
+    if(graphics_init_buffers() < 0) {
+        uart_puts("[ERROR] Back buffer ayrilamadi!\n");
+        while(1) { __asm__ volatile("wfe"); }
+    }
 
     /* Tema başlat */
     uart_puts("[INIT] Tema sistemi baslatiliyor...\n");
@@ -167,6 +215,11 @@ void kernel_main(void) {
 
     uart_puts("[INIT] Sistem hazir!\n");
     uart_puts("\n");
+
+#ifdef CONFIG_BENCH
+    bench_run_all();
+#endif
+
     uart_puts("Kontroller:\n");
     uart_puts("  W/S veya Yukari/Asagi : Kategori degistir\n");
     uart_puts("  A/D veya Sol/Sag     : Oge sec\n");
@@ -174,48 +227,94 @@ void kernel_main(void) {
     uart_puts("  X/Escape             : Geri (B)\n");
     uart_puts("\n");
 
-    /* Frame zamanlama */
+    /* Frame zamanlama: mutlak hedefler, aradaki süre wfi ile uyunur */
     uint32_t frame_count = 0;
-    uint32_t fps_timer = timer_get_ms();
+    uint64_t stats_start = timer_get_ticks();
+    uint64_t stats_idle = timer_idle_ticks();
+    uint64_t stats_presented = 0;
+    uint64_t stats_tiles = 0;
+    uint64_t next_frame = stats_start;
 
     /* Ana döngü */
     while(1) {
-        uint32_t frame_start = timer_get_ms();
+        next_frame += FRAME_TIME_US;
 
         /* Animasyon sistemi güncelle */
-        anim_system_update();
+        {
+            PROF_ZONE("anim");
+            anim_system_update();
+        }
 
         /* Saat güncelle */
         clock_update();
 
         /* Input güncelle */
-        input_update();
+        {
+            PROF_ZONE("input");
+            input_update();
+        }
 
         /* Input işle */
         handle_input();
 
         /* Mevcut ekranı güncelle */
-        update_current_screen();
+        {
+            PROF_ZONE("update");
+            update_current_screen();
+        }
 
-        /* Render (back buffer'a çiz) */
-        render_current_screen();
+        /* Render: çizim listesini kaydet, sadece değişen karoları çiz */
+        int changed;
+        {
+            PROF_ZONE("render");
+            changed = displist_render(render_current_screen);
+        }
 
-        /* Buffer swap (back buffer'ı framebuffer'a kopyala) */
-        graphics_swap_buffers();
+        /* Buffer swap (sayfa çevir veya back buffer'ı kopyala), frame aynıysa yok */
+        if(changed) {
+            PROF_ZONE("swap");
+            graphics_swap_buffers();
+            stats_presented += graphics_presented_bytes();
+        }
+        stats_tiles += displist_raster_tiles();
+
+        /* Profil: frame dökümü (PROF=1) */
+        prof_frame_end();
 
-        /* FPS sayacı */
+        /* FPS ve meşgul/boşta oranı, saniyede bir */
         frame_count++;
-        if(timer_get_ms() - fps_timer >= 1000) {
-            /* Her saniye FPS'i logla (debug için) */
-            /* uart_puts("FPS: "); uart_hex(frame_count); uart_puts("\n"); */
+        uint64_t now = timer_get_ticks();
+        if(now - stats_start >= 1000000) {
+            uint64_t elapsed = now - stats_start;
+            uint64_t idle = timer_idle_ticks() - stats_idle;
+            uint32_t idle_pct = (uint32_t)(idle * 100 / elapsed);
+
+            uart_puts("[FRAME] FPS: ");
+            uart_dec(frame_count);
+            uart_puts(" mesgul: %");
+            uart_dec(100 - idle_pct);
+            uart_puts(" bosta: %");
+            uart_dec(idle_pct);
+            uart_puts(" sunulan: ");
+            uart_dec((uint32_t)(stats_presented / frame_count / 1024));
+            uart_puts(" KB/frame cizilen: ");
+            uart_dec((uint32_t)(stats_tiles / frame_count));
+            uart_puts(" karo/frame\n");
+
             frame_count = 0;
-            fps_timer = timer_get_ms();
+            stats_presented = 0;
+            stats_tiles = 0;
+            stats_start = now;
+            stats_idle = timer_idle_ticks();
         }
 
-        /* Frame rate limiter */
-        uint32_t frame_time = timer_get_ms() - frame_start;
-        if(frame_time < FRAME_TIME_MS) {
-            timer_wait_ms(FRAME_TIME_MS - frame_time);
+        /* Frame rate limiter: kalan sürede iz kayıtlarını dök, sonra uyu */
+        if(now < next_frame) {
+            trace_drain(next_frame);
+            timer_sleep_until(next_frame);
+        } else {
+            /* Geride kaldık, birikmiş gecikmeyi telafi etmeye çalışma */
+            next_frame = now;
         }
     }
 }
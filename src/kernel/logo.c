@@ -1,6 +1,7 @@
 /* logo.c - Gamepad Logo */
 #include <logo.h>
 #include <graphics.h>
+#include <mm.h>
 
 /* 24x16 GAMEPAD LOGOSU (Renkli) */
 /* Renk kodları: 0=şeffaf, 1=siyah(outline), 2=beyaz(body), 3=gri(gölge),
@@ -36,17 +37,52 @@ static const uint32_t gamepad_palette[8] = {
     0xFFFFD800,  /* 7: Sarı */
 };
 
+/*
+ * Ölçeklenmiş logo yüzeyleri: her ölçek ilk çizimde bir kez üretilir ve
+ * bırakılmaz (displist kaydı yüzeyin işaretçisini raster'a kadar tutar),
+ * şeffaf = 0. LOGO_MAX_SCALE'den büyük ölçekler dikdörtgenlerle çizilir.
+ */
+#define LOGO_MAX_SCALE  8
+
+static Surface logo_surfaces[LOGO_MAX_SCALE + 1];
+
+static const Surface *logo_build(int scale) {
+    if(scale < 1 || scale > LOGO_MAX_SCALE) return 0;
+
+    Surface *s = &logo_surfaces[scale];
+    if(s->pixels) return s;
+
+    s->w = 24 * scale;
+    s->h = 16 * scale;
+    s->stride = s->w * 4;
+    s->format = SURFACE_ARGB8888;
+    s->pixels = (uint32_t *)kmalloc(s->stride * s->h);
+    if(!s->pixels) return 0;
+
+    for(int y = 0; y < s->h; y++) {
+        uint32_t *row = s->pixels + y * s->w;
+        for(int x = 0; x < s->w; x++) {
+            row[x] = gamepad_palette[gamepad_pixels[y / scale][x / scale]];
+        }
+    }
+    s->gen++;
+    return s;
+}
+
 void draw_logo(int x, int y, int scale) {
+    const Surface *s = logo_build(scale);
+    if(s) {
+        blit_colorkey(s, x, y, gamepad_palette[0]);
+        return;
+    }
+
+    /* Bellek yoksa / büyük ölçek: ölçeklenmiş piksel başına bir dikdörtgen */
     for(int row = 0; row < 16; row++) {
         for(int col = 0; col < 24; col++) {
             uint8_t color_idx = gamepad_pixels[row][col];
             if(color_idx != 0) {
-                uint32_t color = gamepad_palette[color_idx];
-                for(int sy = 0; sy < scale; sy++) {
-                    for(int sx = 0; sx < scale; sx++) {
-                        draw_pixel(x + col * scale + sx, y + row * scale + sy, color);
-                    }
-                }
+                draw_rect(x + col * scale, y + row * scale, scale, scale,
+                          gamepad_palette[color_idx]);
             }
         }
     }
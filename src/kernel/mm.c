@@ -0,0 +1,272 @@
+/* mm.c - Fiziksel sayfa ayırıcı, kernel heap (kmalloc) ve arena */
+#include <mm.h>
+#include <mmu.h>
+#include <hw.h>
+#include <smp.h>
+
+/*
+ * Sayfa ayırıcı: __bss_end'den ARM/GPU bölünmesine kadar olan RAM için
+ * bit haritası (1 = dolu). Ardışık çok sayfalı ayırmalar (framebuffer
+ * boyutunda tamponlar) için ilk uyan (first-fit) arama yapılır.
+ */
+#define MM_MAX_PAGES        (MMU_PERIPH_BASE >> PAGE_SHIFT)
+#define MM_FALLBACK_END     0x1C000000UL    /* Mailbox cevap vermezse: 448MB */
+
+extern uint8_t __bss_end[];
+
+static uint64_t page_bitmap[MM_MAX_PAGES / 64];
+static size_t first_page;
+static size_t end_page;
+static size_t free_pages;
+static Spinlock page_lock;
+
+static int page_is_used(size_t page) {
+    return (page_bitmap[page >> 6] >> (page & 63)) & 1;
+}
+
+static void page_mark(size_t start, size_t count, int used) {
+    for(size_t i = start; i < start + count; i++) {
+        if(used) {
+            page_bitmap[i >> 6] |= 1ULL << (i & 63);
+        } else {
+            page_bitmap[i >> 6] &= ~(1ULL << (i & 63));
+        }
+    }
+}
+
+void mm_init(void) {
+    uint32_t mem_base = 0, mem_size = 0;
+    uintptr_t mem_end;
+
+    if(hw_get_arm_memory(&mem_base, &mem_size) == 0 && mem_size != 0) {
+        mem_end = (uintptr_t)mem_base + mem_size;
+    } else {
+        uart_puts("[MM] ARM bellek boyutu alinamadi, varsayilan kullaniliyor\n");
+        mem_end = MM_FALLBACK_END;
+    }
+    if(mem_end > MMU_PERIPH_BASE) mem_end = MMU_PERIPH_BASE;
+
+    first_page = ((uintptr_t)__bss_end + PAGE_SIZE - 1) >> PAGE_SHIFT;
+    end_page = mem_end >> PAGE_SHIFT;
+
+    /* Hepsi dolu, sonra kullanılabilir aralığı boşalt */
+    for(size_t i = 0; i < MM_MAX_PAGES / 64; i++) {
+        page_bitmap[i] = ~0ULL;
+    }
+    free_pages = 0;
+    if(end_page > first_page) {
+        page_mark(first_page, end_page - first_page, 0);
+        free_pages = end_page - first_page;
+    }
+
+    uart_puts("[MM] Heap: 0x");
+    uart_hex((uint32_t)(first_page << PAGE_SHIFT));
+    uart_puts(" - 0x");
+    uart_hex((uint32_t)mem_end);
+    uart_puts(", sayfa: 0x");
+    uart_hex((uint32_t)free_pages);
+    uart_puts("\n");
+}
+
+void *page_alloc(size_t pages) {
+    if(pages == 0) return 0;
+
+    spin_lock(&page_lock);
+
+    size_t run = 0, start = 0;
+    for(size_t i = first_page; i < end_page; i++) {
+        /* Tamamen dolu 64 sayfalık kelimeyi atla */
+        if((i & 63) == 0 && page_bitmap[i >> 6] == ~0ULL) {
+            run = 0;
+            i += 63;
+            continue;
+        }
+        if(page_is_used(i)) {
+            run = 0;
+            continue;
+        }
+        if(run == 0) start = i;
+        if(++run == pages) {
+            page_mark(start, pages, 1);
+            free_pages -= pages;
+            spin_unlock(&page_lock);
+            return (void *)(start << PAGE_SHIFT);
+        }
+    }
+
+    spin_unlock(&page_lock);
+    return 0;
+}
+
+void page_free(void *addr, size_t pages) {
+    size_t start = (uintptr_t)addr >> PAGE_SHIFT;
+
+    if(!addr || pages == 0) return;
+    if(start < first_page || start + pages > end_page) {
+        uart_puts("[MM] Gecersiz page_free: 0x");
+        uart_hex((uint32_t)(uintptr_t)addr);
+        uart_puts("\n");
+        return;
+    }
+
+    spin_lock(&page_lock);
+    page_mark(start, pages, 0);
+    free_pages += pages;
+    spin_unlock(&page_lock);
+}
+
+size_t page_total(void) {
+    return end_page > first_page ? end_page - first_page : 0;
+}
+
+size_t page_free_count(void) {
+    return free_pages;
+}
+
+/*
+ * kmalloc: 16..2048 bayt için 2'nin kuvveti boyut sınıfları. Her slab bir
+ * sayfadır; sayfanın ilk 64 baytı başlıktır, kfree adresi sayfaya
+ * yuvarlayıp başlığa bakarak sınıfı bulur. Büyük ayırmalar doğrudan
+ * sayfalardan gelir ve aynı 64 baytlık başlığı taşır.
+ */
+#define KM_HEADER_SIZE      64
+#define KM_MIN_SHIFT        4           /* 16 bayt */
+#define KM_CLASSES          8           /* 16 .. 2048 */
+#define KM_MAX_SLAB         (1 << (KM_MIN_SHIFT + KM_CLASSES - 1))
+#define KM_SLAB_MAGIC       0x534C4142  /* "SLAB" */
+#define KM_LARGE_MAGIC      0x4C415247  /* "LARG" */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t cls;       /* Slab: boyut sınıfı */
+    uint32_t pages;     /* Büyük: sayfa sayısı */
+    uint32_t in_use;    /* Slab: kullanımdaki nesne */
+} KmHeader;
+
+typedef struct KmFree {
+    struct KmFree *next;
+} KmFree;
+
+static KmFree *km_free_lists[KM_CLASSES];
+static Spinlock km_lock;
+
+static int km_class(size_t size) {
+    int cls = 0;
+    size_t obj = 1 << KM_MIN_SHIFT;
+    while(obj < size) {
+        obj <<= 1;
+        cls++;
+    }
+    return cls;
+}
+
+/* Sınıf için yeni slab sayfası ayır ve nesneleri boş listeye ekle */
+static int km_grow(int cls) {
+    uint8_t *page = (uint8_t *)page_alloc(1);
+    if(!page) return -1;
+
+    KmHeader *hdr = (KmHeader *)page;
+    hdr->magic = KM_SLAB_MAGIC;
+    hdr->cls = cls;
+    hdr->pages = 1;
+    hdr->in_use = 0;
+
+    size_t obj = (size_t)1 << (KM_MIN_SHIFT + cls);
+    for(size_t off = KM_HEADER_SIZE; off + obj <= PAGE_SIZE; off += obj) {
+        KmFree *f = (KmFree *)(page + off);
+        f->next = km_free_lists[cls];
+        km_free_lists[cls] = f;
+    }
+    return 0;
+}
+
+void *kmalloc(size_t size) {
+    if(size == 0) return 0;
+
+    if(size > KM_MAX_SLAB) {
+        size_t pages = (size + KM_HEADER_SIZE + PAGE_SIZE - 1) >> PAGE_SHIFT;
+        uint8_t *base = (uint8_t *)page_alloc(pages);
+        if(!base) return 0;
+
+        KmHeader *hdr = (KmHeader *)base;
+        hdr->magic = KM_LARGE_MAGIC;
+        hdr->cls = 0;
+        hdr->pages = (uint32_t)pages;
+        hdr->in_use = 1;
+        return base + KM_HEADER_SIZE;
+    }
+
+    int cls = km_class(size);
+
+    spin_lock(&km_lock);
+    if(!km_free_lists[cls] && km_grow(cls) < 0) {
+        spin_unlock(&km_lock);
+        return 0;
+    }
+    KmFree *f = km_free_lists[cls];
+    km_free_lists[cls] = f->next;
+    ((KmHeader *)((uintptr_t)f & ~(uintptr_t)(PAGE_SIZE - 1)))->in_use++;
+    spin_unlock(&km_lock);
+
+    return f;
+}
+
+void *kzalloc(size_t size) {
+    void *p = kmalloc(size);
+    if(p) memset(p, 0, size);
+    return p;
+}
+
+void kfree(void *ptr) {
+    if(!ptr) return;
+
+    KmHeader *hdr = (KmHeader *)((uintptr_t)ptr & ~(uintptr_t)(PAGE_SIZE - 1));
+
+    if(hdr->magic == KM_LARGE_MAGIC) {
+        hdr->magic = 0;
+        page_free(hdr, hdr->pages);
+    } else if(hdr->magic == KM_SLAB_MAGIC) {
+        KmFree *f = (KmFree *)ptr;
+        spin_lock(&km_lock);
+        f->next = km_free_lists[hdr->cls];
+        km_free_lists[hdr->cls] = f;
+        hdr->in_use--;
+        spin_unlock(&km_lock);
+    } else {
+        uart_puts("[MM] Gecersiz kfree: 0x");
+        uart_hex((uint32_t)(uintptr_t)ptr);
+        uart_puts("\n");
+    }
+}
+
+int arena_init(Arena *arena, size_t size) {
+    size_t pages = (size + PAGE_SIZE - 1) >> PAGE_SHIFT;
+
+    arena->base = (uint8_t *)page_alloc(pages);
+    arena->size = arena->base ? pages << PAGE_SHIFT : 0;
+    arena->used = 0;
+    return arena->base ? 0 : -1;
+}
+
+void *arena_alloc(Arena *arena, size_t size, size_t align) {
+    if(align < 16) align = 16;
+
+    size_t off = (arena->used + align - 1) & ~(align - 1);
+    if(off + size > arena->size) return 0;
+
+    arena->used = off + size;
+    return arena->base + off;
+}
+
+void arena_reset(Arena *arena) {
+    arena->used = 0;
+}
+
+void arena_destroy(Arena *arena) {
+    if(arena->base) {
+        page_free(arena->base, arena->size >> PAGE_SHIFT);
+    }
+    arena->base = 0;
+    arena->size = 0;
+    arena->used = 0;
+}
@@ -0,0 +1,199 @@
+/* mmu.c - Kimlik eşlemeli (identity) sayfa tabloları ve önbellek yönetimi */
+#include <mmu.h>
+
+/*
+ * Bellek haritası (4KB granül, T0SZ=32 -> 4GB sanal adres, L1'den başlar):
+ *   L1[0] -> L2 tablosu (ilk 1GB, 2MB bloklar)
+ *            0x00000000 - 0x3EFFFFFF : Normal, Write-Back (DRAM)
+ *            0x3F000000 - 0x3FFFFFFF : Device-nGnRE (BCM2837 çevre birimleri)
+ *   L1[1] -> 1GB blok, Device-nGnRE (0x40000000 ARM local çevre birimleri)
+ * Framebuffer, init_screen() sonrası mmu_map_range() ile Normal-NC yapılır.
+ */
+
+#define PT_ENTRIES      512
+
+/* Tanımlayıcı bitleri */
+#define PT_VALID        (1UL << 0)
+#define PT_TABLE        (1UL << 1)
+#define PT_BLOCK        (0UL << 1)
+#define PT_ATTR(i)      ((uint64_t)(i) << 2)
+#define PT_AP_RW        (0UL << 6)
+#define PT_SH_OUTER     (2UL << 8)
+#define PT_SH_INNER     (3UL << 8)
+#define PT_AF           (1UL << 10)
+#define PT_PXN          (1UL << 53)
+#define PT_UXN          (1UL << 54)
+
+/* MAIR_EL1: attr0=Device-nGnRE, attr1=Normal WB RA/WA, attr2=Normal NC */
+#define MAIR_VALUE      ((0x04UL << (8 * MMU_ATTR_DEVICE)) | \
+                         (0xFFUL << (8 * MMU_ATTR_NORMAL)) | \
+                         (0x44UL << (8 * MMU_ATTR_NORMAL_NC)))
+
+/* TCR_EL1: T0SZ=32, WB/WA tablo yürüyüşü, inner shareable, 4KB, TTBR1 kapalı */
+#define TCR_T0SZ        (32UL << 0)
+#define TCR_IRGN0_WBWA  (1UL << 8)
+#define TCR_ORGN0_WBWA  (1UL << 10)
+#define TCR_SH0_INNER   (3UL << 12)
+#define TCR_TG0_4K      (0UL << 14)
+#define TCR_EPD1        (1UL << 23)
+#define TCR_VALUE       (TCR_T0SZ | TCR_IRGN0_WBWA | TCR_ORGN0_WBWA | \
+                         TCR_SH0_INNER | TCR_TG0_4K | TCR_EPD1)
+
+/* SCTLR_EL1 bitleri */
+#define SCTLR_M         (1UL << 0)      /* MMU */
+#define SCTLR_A         (1UL << 1)      /* Hizalama kontrolü */
+#define SCTLR_C         (1UL << 2)      /* Veri önbelleği */
+#define SCTLR_I         (1UL << 12)     /* Komut önbelleği */
+
+static uint64_t l1_table[PT_ENTRIES] __attribute__((aligned(4096)));
+static uint64_t l2_table[PT_ENTRIES] __attribute__((aligned(4096)));
+
+/* 2MB blok tanımlayıcısı oluştur */
+static uint64_t block_desc(uintptr_t addr, int attr) {
+    uint64_t desc = addr | PT_VALID | PT_BLOCK | PT_AF | PT_AP_RW | PT_ATTR(attr);
+
+    if(attr == MMU_ATTR_NORMAL) {
+        desc |= PT_SH_INNER;
+    } else if(attr == MMU_ATTR_NORMAL_NC) {
+        desc |= PT_SH_OUTER | PT_PXN | PT_UXN;
+    } else {
+        desc |= PT_PXN | PT_UXN;
+    }
+    return desc;
+}
+
+static uint64_t dcache_line_size(void) {
+    uint64_t ctr;
+    __asm__ volatile("mrs %0, ctr_el0" : "=r"(ctr));
+    return 4UL << ((ctr >> 16) & 0xF);
+}
+
+void dcache_clean_range(const void *addr, size_t len) {
+    uint64_t line = dcache_line_size();
+    uintptr_t p = (uintptr_t)addr & ~(line - 1);
+    uintptr_t end = (uintptr_t)addr + len;
+
+    for(; p < end; p += line) {
+        __asm__ volatile("dc cvac, %0" : : "r"(p) : "memory");
+    }
+    __asm__ volatile("dsb sy" : : : "memory");
+}
+
+void dcache_invalidate_range(const void *addr, size_t len) {
+    uint64_t line = dcache_line_size();
+    uintptr_t p = (uintptr_t)addr & ~(line - 1);
+    uintptr_t end = (uintptr_t)addr + len;
+
+    for(; p < end; p += line) {
+        __asm__ volatile("dc ivac, %0" : : "r"(p) : "memory");
+    }
+    __asm__ volatile("dsb sy" : : : "memory");
+}
+
+void dcache_flush_range(const void *addr, size_t len) {
+    uint64_t line = dcache_line_size();
+    uintptr_t p = (uintptr_t)addr & ~(line - 1);
+    uintptr_t end = (uintptr_t)addr + len;
+
+    for(; p < end; p += line) {
+        __asm__ volatile("dc civac, %0" : : "r"(p) : "memory");
+    }
+    __asm__ volatile("dsb sy" : : : "memory");
+}
+
+int mmu_is_enabled(void) {
+    uint64_t sctlr;
+    __asm__ volatile("mrs %0, sctlr_el1" : "=r"(sctlr));
+    return (sctlr & SCTLR_M) != 0;
+}
+
+/* Sayfa tablolarını bu çekirdekte etkinleştir (tablolar hazır olmalı) */
+void mmu_enable(void) {
+    uint64_t sctlr;
+
+    __asm__ volatile("msr mair_el1, %0" : : "r"(MAIR_VALUE));
+    __asm__ volatile("msr tcr_el1, %0" : : "r"(TCR_VALUE));
+    __asm__ volatile("msr ttbr0_el1, %0" : : "r"((uint64_t)(uintptr_t)l1_table));
+    __asm__ volatile("isb");
+
+    /* Eski TLB ve komut önbelleği girdilerini temizle */
+    __asm__ volatile("tlbi vmalle1\n"
+                     "dsb ish\n"
+                     "ic iallu\n"
+                     "dsb ish\n"
+                     "isb" : : : "memory");
+
+    __asm__ volatile("mrs %0, sctlr_el1" : "=r"(sctlr));
+    sctlr |= SCTLR_M | SCTLR_C | SCTLR_I;
+    sctlr &= ~SCTLR_A;
+    __asm__ volatile("msr sctlr_el1, %0\n"
+                     "isb" : : "r"(sctlr) : "memory");
+}
+
+/* Tabloları kur ve MMU + L1/L2 önbellekleri aç */
+void mmu_init(void) {
+    for(int i = 0; i < PT_ENTRIES; i++) {
+        l1_table[i] = 0;
+    }
+
+    /* İlk 1GB: 2MB bloklar */
+    for(int i = 0; i < PT_ENTRIES; i++) {
+        uintptr_t addr = (uintptr_t)i * MMU_BLOCK_SIZE;
+        int attr = (addr >= MMU_PERIPH_BASE) ? MMU_ATTR_DEVICE : MMU_ATTR_NORMAL;
+        l2_table[i] = block_desc(addr, attr);
+    }
+
+    l1_table[0] = (uint64_t)(uintptr_t)l2_table | PT_VALID | PT_TABLE;
+
+    /* 0x40000000: ARM local (BCM2836) çevre birimleri, 1GB blok */
+    l1_table[1] = MMU_LOCAL_BASE | PT_VALID | PT_BLOCK | PT_AF |
+                  PT_ATTR(MMU_ATTR_DEVICE) | PT_PXN | PT_UXN;
+
+    /* Tablo yürüyüşü önbellekten okur; tabloları belleğe yaz */
+    dcache_flush_range(l1_table, sizeof(l1_table));
+    dcache_flush_range(l2_table, sizeof(l2_table));
+
+    mmu_enable();
+}
+
+/*
+ * Bölgenin bellek tipini değiştir (sadece ilk 1GB RAM bölgesi).
+ * Çalışırken de çağrılır (graphics_set_scale): tip değişimi ARMv8'de
+ * break-before-make ister. Önce bloklar geçersiz yapılır ve TLB tüm
+ * çekirdeklerde temizlenir, sonra yeni tanımlayıcı yazılır. Arada bölgeye
+ * erişen çekirdek hata alır; çağıran bölgenin o sırada kullanılmadığını
+ * garanti eder.
+ */
+void mmu_map_range(uintptr_t base, size_t size, int attr) {
+    uintptr_t start = base & ~(MMU_BLOCK_SIZE - 1);
+    uintptr_t end = (base + size + MMU_BLOCK_SIZE - 1) & ~(MMU_BLOCK_SIZE - 1);
+    if(end > MMU_PERIPH_BASE) end = MMU_PERIPH_BASE;
+    if(start >= end) return;
+
+    int enabled = mmu_is_enabled();
+
+    /* Önbellekte kalmış kirli satırları tip değişmeden önce belleğe yaz */
+    if(enabled) {
+        dcache_flush_range((const void *)start, end - start);
+    }
+
+    /* Break: eski tanımlayıcıları kaldır, TLB'den sil */
+    for(uintptr_t addr = start; addr < end; addr += MMU_BLOCK_SIZE) {
+        l2_table[addr / MMU_BLOCK_SIZE] = 0;
+    }
+    __asm__ volatile("dsb ishst\n"
+                     "tlbi vmalle1is\n"
+                     "dsb ish" : : : "memory");
+
+    /* Make: yeni tipte blokları yaz */
+    for(uintptr_t addr = start; addr < end; addr += MMU_BLOCK_SIZE) {
+        l2_table[addr / MMU_BLOCK_SIZE] = block_desc(addr, attr);
+    }
+    __asm__ volatile("dsb ishst\n"
+                     "isb" : : : "memory");
+
+    /* Eski eşlemeyle spekülatif dolan satırlar yeni tiple çakışmasın */
+    if(enabled) {
+        dcache_flush_range((const void *)start, end - start);
+    }
+}
@@ -0,0 +1,190 @@
+/* prof.c - Cortex-A53 PMU tabanlı bölge (zone) profilleyici (make PROF=1) */
+#include <prof.h>
+#include <hw.h>
+#include <smp.h>
+
+#ifdef CONFIG_PROF
+
+/* Cortex-A53 PMU olayları */
+#define PMU_EVT_L1D_CACHE_REFILL    0x03
+#define PMU_EVT_INST_RETIRED        0x08
+
+/* PMCR_EL0 bitleri */
+#define PMCR_E      (1 << 0)    /* Sayaçları aç */
+#define PMCR_P      (1 << 1)    /* Olay sayaçlarını sıfırla */
+#define PMCR_C      (1 << 2)    /* Çevrim sayacını sıfırla */
+
+typedef struct {
+    const char *name;
+    uint32_t calls;
+    uint64_t cycles;
+    uint64_t l1d_refill;
+    uint64_t instructions;
+} ProfZoneStat;
+
+static ProfZoneStat zones[PROF_MAX_ZONES];
+static int zone_count = 0;
+static int zones_announced = 0;
+static uint32_t frame_number = 0;
+static uint32_t frames_in_interval = 0;
+static uint64_t interval_start = 0;
+
+/* Karo raster süreleri (aralık boyunca toplanır) */
+static uint64_t tile_ticks[PROF_MAX_TILES];
+static int tile_cols = 0, tile_rows = 0;
+
+static inline uint64_t pmu_cycles(void) {
+    uint64_t v;
+    __asm__ volatile("mrs %0, pmccntr_el0" : "=r"(v));
+    return v;
+}
+
+static inline uint64_t pmu_event(int n) {
+    uint64_t v;
+    if(n == 0) {
+        __asm__ volatile("mrs %0, pmevcntr0_el0" : "=r"(v));
+    } else {
+        __asm__ volatile("mrs %0, pmevcntr1_el0" : "=r"(v));
+    }
+    return v;
+}
+
+void prof_init(void) {
+    /* Sayaç 0: L1D refill, sayaç 1: tamamlanan komut */
+    __asm__ volatile("msr pmevtyper0_el0, %0" : : "r"((uint64_t)PMU_EVT_L1D_CACHE_REFILL));
+    __asm__ volatile("msr pmevtyper1_el0, %0" : : "r"((uint64_t)PMU_EVT_INST_RETIRED));
+    __asm__ volatile("msr pmccfiltr_el0, xzr");
+    __asm__ volatile("msr pmcntenset_el0, %0" : : "r"((uint64_t)((1UL << 31) | 0x3)));
+    __asm__ volatile("msr pmcr_el0, %0\n"
+                     "isb" : : "r"((uint64_t)(PMCR_E | PMCR_P | PMCR_C)));
+
+    interval_start = pmu_cycles();
+    uart_puts("[PROF] PMU profilleyici aktif\n");
+}
+
+ProfScope prof_zone_begin(ProfZoneDef *zone) {
+    ProfScope scope;
+
+    scope.zone = 0;
+    if(smp_core_id() != 0) return scope;
+
+    if(zone->id < 0) {
+        if(zone_count >= PROF_MAX_ZONES) return scope;
+        zone->id = zone_count++;
+        zones[zone->id].name = zone->name;
+    }
+
+    scope.zone = zone;
+    scope.l1d_refill = pmu_event(0);
+    scope.instructions = pmu_event(1);
+    __asm__ volatile("isb");
+    scope.cycles = pmu_cycles();
+    return scope;
+}
+
+void prof_zone_end(ProfScope *scope) {
+    if(!scope->zone) return;
+
+    uint64_t cycles = pmu_cycles();
+    __asm__ volatile("isb");
+    ProfZoneStat *z = &zones[scope->zone->id];
+
+    z->calls++;
+    z->cycles += cycles - scope->cycles;
+    /* Olay sayaçları 32 bit */
+    z->l1d_refill += (uint32_t)(pmu_event(0) - scope->l1d_refill);
+    z->instructions += (uint32_t)(pmu_event(1) - scope->instructions);
+}
+
+void prof_tiles(const uint32_t *ticks, int cols, int rows) {
+    if(cols * rows > PROF_MAX_TILES) return;
+    tile_cols = cols;
+    tile_rows = rows;
+    for(int i = 0; i < cols * rows; i++) {
+        tile_ticks[i] += ticks[i];
+    }
+}
+
+/* CSV: sayı yazma (UART'ta hex yerine okunabilir olsun) */
+static void put_u64(uint64_t v) {
+    char buf[21];
+    int i = 20;
+    buf[i] = 0;
+    do {
+        buf[--i] = '0' + (v % 10);
+        v /= 10;
+    } while(v);
+    uart_puts(&buf[i]);
+}
+
+void prof_frame_end(void) {
+    frame_number++;
+    if(++frames_in_interval < PROF_FRAME_INTERVAL) return;
+
+    uint64_t now = pmu_cycles();
+
+    /* Yeni bölgelerin adlarını bir kez duyur */
+    for(; zones_announced < zone_count; zones_announced++) {
+        uart_puts("N,");
+        put_u64(zones_announced);
+        uart_puts(",");
+        uart_puts((char *)zones[zones_announced].name);
+        uart_puts("\n");
+    }
+
+    uart_puts("F,");
+    put_u64(frame_number);
+    uart_puts(",");
+    put_u64(frames_in_interval);
+    uart_puts(",");
+    put_u64(now - interval_start);
+    uart_puts("\n");
+
+    for(int i = 0; i < zone_count; i++) {
+        ProfZoneStat *z = &zones[i];
+        if(z->calls == 0) continue;
+
+        uart_puts("P,");
+        put_u64(frame_number);
+        uart_puts(",");
+        put_u64(i);
+        uart_puts(",");
+        put_u64(z->calls);
+        uart_puts(",");
+        put_u64(z->cycles);
+        uart_puts(",");
+        put_u64(z->l1d_refill);
+        uart_puts(",");
+        put_u64(z->instructions);
+        uart_puts("\n");
+
+        z->calls = 0;
+        z->cycles = 0;
+        z->l1d_refill = 0;
+        z->instructions = 0;
+    }
+
+    if(tile_cols) {
+        uint64_t freq;
+        __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+
+        uart_puts("T,");
+        put_u64(frame_number);
+        uart_puts(",");
+        put_u64(tile_cols);
+        uart_puts(",");
+        put_u64(tile_rows);
+        for(int i = 0; i < tile_cols * tile_rows; i++) {
+            uart_puts(",");
+            put_u64(tile_ticks[i] * 1000000000ULL / freq / frames_in_interval);
+            tile_ticks[i] = 0;
+        }
+        uart_puts("\n");
+    }
+
+    frames_in_interval = 0;
+    /* UART yazımı bir sonraki aralığa sayılmasın */
+    interval_start = pmu_cycles();
+}
+
+#endif
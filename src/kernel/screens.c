@@ -8,6 +8,7 @@
 #include <ui/animation.h>
 #include <ui/transition.h>
 #include <ui/menu.h>
+#include <ui/compositor.h>
 
 /* Ekran durumu */
 ScreenType current_screen = SCREEN_WELCOME;
@@ -36,11 +37,14 @@ static void draw_screen_footer(const char *text) {
 
 /* --- HOŞGELDİNİZ EKRANI (ORİJİNAL/ESKİ HALİ) --- */
 
-void draw_welcome_screen(void) {
+/* Gradient arka plan (saklı katman) */
+static void draw_welcome_bg(void) {
     Theme *t = theme_get();
-
-    /* Gradient arka plan */
     draw_gradient_bg(t->bg_dark, t->bg_medium);
+}
+
+static void draw_welcome_content(void) {
+    Theme *t = theme_get();
 
     float logo_scale_anim = anim_get_value(&welcome_logo_anim);
     float text_alpha_anim = anim_get_value(&welcome_text_anim);
@@ -83,6 +87,15 @@ void draw_welcome_screen(void) {
     }
 }
 
+static Layer welcome_layers[] = {
+    { .kind = LAYER_STATIC, .x = 0, .y = 0, .w = SCREEN_WIDTH, .h = SCREEN_HEIGHT, .draw = draw_welcome_bg },
+    { .kind = LAYER_DYNAMIC, .draw = draw_welcome_content }
+};
+
+void draw_welcome_screen(void) {
+    compositor_draw(welcome_layers, 2);
+}
+
 void update_welcome_screen(void) {
     if(!welcome_initialized) {
         anim_init(&welcome_logo_anim);
@@ -128,10 +141,14 @@ void update_files_screen(void) { filemgr_update(); }
 
 /* --- AYARLAR EKRANI (YENİ FLAT TASARIM) --- */
 
-void draw_settings_screen(void) {
+/* Arka plan, başlık ve alt bilgi (saklı katman) */
+static void draw_settings_frame(void) {
     draw_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0xFF1A1A1A);
     draw_screen_header("Ayarlar");
+    draw_screen_footer("[B] Geri");
+}
 
+static void draw_settings_cards(void) {
     int x = 30;
     int start_y = 90;
     int h = 70;
@@ -173,8 +190,15 @@ void draw_settings_screen(void) {
     draw_rect(x, y, w, h, 0xFF252525);
     draw_text_20_medium(x + 20, y + 25, "WiFi", 0xFFFFFFFF);
     draw_text_16(x + w - 80, y + 25, "Kapali", 0xFF555555);
+}
 
-    draw_screen_footer("[B] Geri");
+static Layer settings_layers[] = {
+    { .kind = LAYER_STATIC, .x = 0, .y = 0, .w = SCREEN_WIDTH, .h = SCREEN_HEIGHT, .draw = draw_settings_frame },
+    { .kind = LAYER_DYNAMIC, .draw = draw_settings_cards }
+};
+
+void draw_settings_screen(void) {
+    compositor_draw(settings_layers, 2);
 }
 
 void update_settings_screen(void) {
@@ -183,10 +207,13 @@ void update_settings_screen(void) {
 
 /* --- HAKKINDA EKRANI (YENİ FLAT TASARIM) --- */
 
-void draw_about_screen(void) {
+static void draw_about_frame(void) {
     draw_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0xFF1A1A1A);
     draw_screen_header("Hakkında");
+    draw_screen_footer("[B] Geri");
+}
 
+static void draw_about_card(void) {
     int card_w = 460;
     int card_h = 300;
     int card_x = (SCREEN_WIDTH - card_w) / 2;
@@ -220,8 +247,15 @@ void draw_about_screen(void) {
 
     ty += 25;
     draw_text_16(logo_x - 100, ty, "Platform: Raspberry Pi Zero 2W", 0xFF666666);
+}
 
-    draw_screen_footer("[B] Geri");
+static Layer about_layers[] = {
+    { .kind = LAYER_STATIC, .x = 0, .y = 0, .w = SCREEN_WIDTH, .h = SCREEN_HEIGHT, .draw = draw_about_frame },
+    { .kind = LAYER_DYNAMIC, .draw = draw_about_card }
+};
+
+void draw_about_screen(void) {
+    compositor_draw(about_layers, 2);
 }
 
 void update_about_screen(void) {
@@ -0,0 +1,143 @@
+/* smp.c - Çok çekirdek (SMP) başlatma ve iş gönderme */
+#include <smp.h>
+#include <hw.h>
+#include <mmu.h>
+#include <drivers/timer.h>
+
+/*
+ * Firmware (armstub8) ikincil çekirdekleri 0xD8 + 8*çekirdek adresindeki
+ * spin-table girdisini bekleterek tutar. Girdiye giriş adresi yazılıp
+ * sev yapılınca çekirdek oraya zıplar (EL2, MMU kapalı).
+ */
+#define SPIN_TABLE_BASE     0xD8
+#define SMP_START_TIMEOUT   100000      /* us */
+
+extern void _secondary_start(void);
+
+/* Çekirdek başına iş yuvası (ayrı önbellek satırında) */
+typedef struct {
+    smp_job_fn fn;
+    void *arg;
+    uint32_t busy;
+    uint32_t online;
+} __attribute__((aligned(64))) CoreSlot;
+
+static CoreSlot core_slots[SMP_MAX_CORES];
+static uint8_t core_stacks[SMP_MAX_CORES][SMP_STACK_SIZE] __attribute__((aligned(16)));
+
+/* start.s bu tablodan yığın tepesini okur (MMU kapalıyken) */
+uint64_t smp_core_stack[SMP_MAX_CORES];
+
+static int online_cores = 1;
+static smp_idle_fn idle_fn;
+
+/* İkincil çekirdek ana döngüsü (start.s'ten, MMU açık) */
+void smp_secondary_main(uint64_t core) {
+    CoreSlot *slot = &core_slots[core];
+
+    __atomic_store_n(&slot->online, 1, __ATOMIC_RELEASE);
+    smp_sev();
+
+    while(1) {
+        smp_job_fn fn = __atomic_load_n(&slot->fn, __ATOMIC_ACQUIRE);
+        if(!fn) {
+            smp_idle_fn idle = __atomic_load_n(&idle_fn, __ATOMIC_ACQUIRE);
+            if(!idle || !idle()) {
+                __asm__ volatile("wfe");
+            }
+            continue;
+        }
+
+        fn(slot->arg);
+
+        __atomic_store_n(&slot->fn, (smp_job_fn)0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->busy, 0, __ATOMIC_RELEASE);
+        smp_sev();
+    }
+}
+
+static void spin_table_release(int core) {
+    uintptr_t entry = SPIN_TABLE_BASE + 8 * core;
+    uint64_t addr = (uint64_t)(uintptr_t)_secondary_start;
+
+    /* Sabit düşük adrese C ile yazmak derleyici uyarısı verir, asm ile yaz */
+    __asm__ volatile("str %0, [%1]" : : "r"(addr), "r"(entry) : "memory");
+
+    /* Çekirdek MMU kapalı okur: girdiyi belleğe yaz */
+    dcache_clean_range((const void *)entry, 8);
+}
+
+void smp_init(void) {
+    for(int core = 1; core < SMP_MAX_CORES; core++) {
+        smp_core_stack[core] = (uint64_t)(uintptr_t)&core_stacks[core][SMP_STACK_SIZE];
+    }
+    dcache_clean_range(smp_core_stack, sizeof(smp_core_stack));
+
+    for(int core = 1; core < SMP_MAX_CORES; core++) {
+        spin_table_release(core);
+        smp_sev();
+
+        /* Çekirdeğin çevrimiçi olmasını bekle */
+        uint64_t start = timer_get_ticks();
+        while(!__atomic_load_n(&core_slots[core].online, __ATOMIC_ACQUIRE)) {
+            if(timer_get_ticks() - start > SMP_START_TIMEOUT) break;
+        }
+
+        if(core_slots[core].online) {
+            online_cores++;
+            uart_puts("[SMP] Cekirdek ");
+            uart_hex(core);
+            uart_puts(" aktif\n");
+        } else {
+            uart_puts("[SMP] Cekirdek ");
+            uart_hex(core);
+            uart_puts(" yanit vermedi!\n");
+        }
+    }
+}
+
+void smp_set_idle(smp_idle_fn fn) {
+    __atomic_store_n(&idle_fn, fn, __ATOMIC_RELEASE);
+    smp_sev();
+}
+
+int smp_num_cores(void) {
+    return online_cores;
+}
+
+int smp_run_on(int core, smp_job_fn fn, void *arg) {
+    if(!fn || core < 0 || core >= SMP_MAX_CORES) return -1;
+
+    CoreSlot *slot = &core_slots[core];
+
+    /* Çekirdek 0 veya çevrimdışı çekirdek: burada çalıştır */
+    if(core == smp_core_id() || !__atomic_load_n(&slot->online, __ATOMIC_ACQUIRE)) {
+        fn(arg);
+        return 0;
+    }
+
+    smp_wait_core(core);
+
+    slot->arg = arg;
+    __atomic_store_n(&slot->busy, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->fn, fn, __ATOMIC_RELEASE);
+    smp_sev();
+    return 0;
+}
+
+int smp_is_busy(int core) {
+    if(core < 0 || core >= SMP_MAX_CORES) return 0;
+    return __atomic_load_n(&core_slots[core].busy, __ATOMIC_ACQUIRE) != 0;
+}
+
+void smp_wait_core(int core) {
+    while(smp_is_busy(core)) {
+        __asm__ volatile("wfe");
+    }
+}
+
+void smp_wait(void) {
+    for(int core = 1; core < SMP_MAX_CORES; core++) {
+        smp_wait_core(core);
+    }
+}
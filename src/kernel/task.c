@@ -0,0 +1,236 @@
+/* task.c - Çekirdekler arası iş çalma (work-stealing) görev sistemi */
+#include <task.h>
+#include <smp.h>
+
+/*
+ * Her çekirdeğin bir Chase-Lev kuyruğu var (Lê ve ark., zayıf bellek modeli):
+ *   - Sahip çekirdek alttan (bottom) ekler ve alır (LIFO, önbellek dostu)
+ *   - Diğer çekirdekler üstten (top) CAS ile çalar (FIFO, büyük parçalar)
+ * Görevler kuyrukta değer olarak tutulur; hırsız alanları okuduktan sonra
+ * CAS başarılıysa okuma geçerlidir (sahip, dolu yuvanın üstüne yazmaz).
+ */
+
+#define TASK_MASK   (TASK_DEQUE_SIZE - 1)
+
+typedef struct {
+    task_fn fn;
+    void *arg;
+    TaskGroup *group;
+} Task;
+
+typedef struct {
+    int64_t top;
+    uint8_t pad0[56];
+    int64_t bottom;
+    uint8_t pad1[56];
+    Task tasks[TASK_DEQUE_SIZE];
+    uint32_t executed;
+    uint32_t stolen;
+} __attribute__((aligned(64))) TaskDeque;
+
+static TaskDeque deques[SMP_MAX_CORES];
+static TaskGroup default_groups[SMP_MAX_CORES];
+
+/* Sahip: alta ekle. Kuyruk doluysa 0 döner */
+static int deque_push(TaskDeque *q, const Task *t) {
+    int64_t b = __atomic_load_n(&q->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&q->top, __ATOMIC_ACQUIRE);
+
+    if(b - top >= TASK_DEQUE_SIZE) return 0;
+
+    Task *slot = &q->tasks[b & TASK_MASK];
+    __atomic_store_n(&slot->fn, t->fn, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->arg, t->arg, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->group, t->group, __ATOMIC_RELAXED);
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&q->bottom, b + 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static void read_slot(TaskDeque *q, int64_t i, Task *out) {
+    Task *slot = &q->tasks[i & TASK_MASK];
+    out->fn = __atomic_load_n(&slot->fn, __ATOMIC_RELAXED);
+    out->arg = __atomic_load_n(&slot->arg, __ATOMIC_RELAXED);
+    out->group = __atomic_load_n(&slot->group, __ATOMIC_RELAXED);
+}
+
+/* Sahip: alttan al */
+static int deque_take(TaskDeque *q, Task *out) {
+    int64_t b = __atomic_load_n(&q->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&q->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&q->top, __ATOMIC_RELAXED);
+
+    if(t > b) {
+        /* Boş */
+        __atomic_store_n(&q->bottom, b + 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    read_slot(q, b, out);
+    if(t == b) {
+        /* Son eleman: hırsızlarla yarış */
+        int won = __atomic_compare_exchange_n(&q->top, &t, t + 1, 0,
+                                              __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+        __atomic_store_n(&q->bottom, b + 1, __ATOMIC_RELAXED);
+        return won;
+    }
+    return 1;
+}
+
+/* Hırsız: üstten çal */
+static int deque_steal(TaskDeque *q, Task *out) {
+    int64_t t = __atomic_load_n(&q->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t b = __atomic_load_n(&q->bottom, __ATOMIC_ACQUIRE);
+
+    if(t >= b) return 0;
+
+    read_slot(q, t, out);
+    return __atomic_compare_exchange_n(&q->top, &t, t + 1, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static void task_finish(TaskGroup *group) {
+    if(__atomic_sub_fetch(&group->pending, 1, __ATOMIC_RELEASE) == 0) {
+        /* task_wait'te uyuyan çekirdeği uyandır */
+        smp_sev();
+    }
+}
+
+static void task_execute(const Task *t) {
+    t->fn(t->arg);
+    task_finish(t->group);
+}
+
+int task_run_one(void) {
+    int core = smp_core_id();
+    Task t;
+
+    if(deque_take(&deques[core], &t)) {
+        deques[core].executed++;
+        task_execute(&t);
+        return 1;
+    }
+
+    for(int i = 1; i < SMP_MAX_CORES; i++) {
+        int victim = (core + i) % SMP_MAX_CORES;
+        if(deque_steal(&deques[victim], &t)) {
+            deques[core].executed++;
+            deques[core].stolen++;
+            task_execute(&t);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void task_init(void) {
+    for(int i = 0; i < SMP_MAX_CORES; i++) {
+        deques[i].top = 0;
+        deques[i].bottom = 0;
+        default_groups[i].pending = 0;
+    }
+    task_stat_reset();
+
+    /* Boştaki ikincil çekirdekler görev çalsın */
+    smp_set_idle(task_run_one);
+}
+
+void task_spawn_in(TaskGroup *group, task_fn fn, void *arg) {
+    Task t = { fn, arg, group };
+
+    __atomic_add_fetch(&group->pending, 1, __ATOMIC_RELAXED);
+
+    if(!deque_push(&deques[smp_core_id()], &t)) {
+        /* Kuyruk dolu: hemen burada çalıştır */
+        task_execute(&t);
+        return;
+    }
+    smp_sev();
+}
+
+void task_wait(TaskGroup *group) {
+    while(__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) != 0) {
+        if(!task_run_one()) {
+            /* Kalan görevler başka çekirdekte çalışıyor */
+            __asm__ volatile("wfe");
+        }
+    }
+}
+
+void task_spawn(task_fn fn, void *arg) {
+    task_spawn_in(&default_groups[smp_core_id()], fn, arg);
+}
+
+void task_group_wait(void) {
+    task_wait(&default_groups[smp_core_id()]);
+}
+
+/* parallel_for parçası */
+typedef struct {
+    task_range_fn fn;
+    void *arg;
+    int begin;
+    int end;
+} RangeChunk;
+
+static void range_task(void *p) {
+    RangeChunk *c = (RangeChunk *)p;
+    c->fn(c->begin, c->end, c->arg);
+}
+
+void parallel_for(int begin, int end, int grain, task_range_fn fn, void *arg) {
+    int len = end - begin;
+    if(len <= 0) return;
+    if(grain < 1) grain = 1;
+
+    int chunks = (len + grain - 1) / grain;
+    if(chunks > TASK_MAX_CHUNKS) chunks = TASK_MAX_CHUNKS;
+
+    /* Tek çekirdek veya tek parça: doğrudan çalıştır */
+    if(chunks <= 1 || smp_num_cores() <= 1) {
+        fn(begin, end, arg);
+        return;
+    }
+
+    RangeChunk parts[TASK_MAX_CHUNKS];
+    TaskGroup group = { 0 };
+    int step = len / chunks;
+    int rem = len % chunks;
+    int pos = begin;
+
+    for(int i = 0; i < chunks; i++) {
+        int size = step + (i < rem ? 1 : 0);
+        parts[i].fn = fn;
+        parts[i].arg = arg;
+        parts[i].begin = pos;
+        parts[i].end = pos + size;
+        pos += size;
+    }
+
+    /* İlk parçayı kendimiz çalıştırırız, kalanlar çalınabilir */
+    for(int i = 1; i < chunks; i++) {
+        task_spawn_in(&group, range_task, &parts[i]);
+    }
+    range_task(&parts[0]);
+    task_wait(&group);
+}
+
+uint32_t task_stat_executed(int core) {
+    if(core < 0 || core >= SMP_MAX_CORES) return 0;
+    return deques[core].executed;
+}
+
+uint32_t task_stat_stolen(int core) {
+    if(core < 0 || core >= SMP_MAX_CORES) return 0;
+    return deques[core].stolen;
+}
+
+void task_stat_reset(void) {
+    for(int i = 0; i < SMP_MAX_CORES; i++) {
+        deques[i].executed = 0;
+        deques[i].stolen = 0;
+    }
+}
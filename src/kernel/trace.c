@@ -0,0 +1,114 @@
+/* trace.c - Çekirdek başına kilitsiz ikili iz halkası ve UART'a boşaltma */
+#include <trace.h>
+#include <hw.h>
+#include <smp.h>
+#include <irq.h>
+#include <bench.h>
+#include <drivers/timer.h>
+
+/*
+ * Her çekirdeğin kendi halkası vardır: yazan yalnızca o çekirdek (tek
+ * üretici), okuyan yalnızca trace_drain() çağıran çekirdek 0 (tek tüketici).
+ * Aynı çekirdekteki kesme ile yarışı önlemek için yazma irq_save altında
+ * yapılır; çekirdekler arası kilit yoktur. Halka doluysa kayıt atılır ve
+ * sayılır, üretici asla beklemez.
+ */
+
+/* Bir satır ("~" + 32 hex + "\n") 115200 baud'da ~3ms sürer */
+#define TRACE_LINE_US   3000
+
+typedef struct {
+    TraceRecord records[TRACE_RING_SIZE];
+    uint32_t head;          /* Üretici yazar */
+    uint32_t tail;          /* Tüketici yazar */
+    uint32_t dropped;       /* Üretici yazar, tüketici sıfırlar (atomik) */
+} __attribute__((aligned(64))) TraceRing;
+
+static TraceRing rings[SMP_MAX_CORES];
+
+void trace_init(void) {
+    for(int i = 0; i < SMP_MAX_CORES; i++) {
+        rings[i].head = 0;
+        rings[i].tail = 0;
+        rings[i].dropped = 0;
+    }
+
+    /* Çözücü zaman damgalarını bu frekansla saniyeye çevirir */
+    uart_puts("~~");
+    uart_hex((unsigned int)bench_freq());
+    uart_puts("\n");
+    uart_puts("[TRACE] Iz halkasi hazir, seviye ");
+    uart_dec(TRACE_LEVEL);
+    uart_puts("\n");
+}
+
+void trace_emit(int level, int event, uint32_t arg0, uint32_t arg1) {
+    int core = smp_core_id();
+    TraceRing *ring = &rings[core];
+    uint64_t flags = irq_save();
+
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if(head - tail >= TRACE_RING_SIZE) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+    } else {
+        TraceRecord *r = &ring->records[head & (TRACE_RING_SIZE - 1)];
+        r->timestamp = (uint32_t)bench_ticks();
+        r->event = (uint16_t)event;
+        r->core = (uint8_t)core;
+        r->level = (uint8_t)level;
+        r->arg0 = arg0;
+        r->arg1 = arg1;
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    }
+
+    irq_restore(flags);
+}
+
+/* Kaydı "~" + 4 kelime hex olarak yaz (trace_decode.py okur) */
+static void trace_put_record(const TraceRecord *r) {
+    uart_puts("~");
+    uart_hex(r->timestamp);
+    uart_hex((unsigned int)r->event | ((unsigned int)r->core << 16) |
+             ((unsigned int)r->level << 24));
+    uart_hex(r->arg0);
+    uart_hex(r->arg1);
+    uart_puts("\n");
+}
+
+void trace_drain(uint64_t deadline) {
+    if(smp_core_id() != 0) return;
+
+    for(int core = 0; core < SMP_MAX_CORES; core++) {
+        TraceRing *ring = &rings[core];
+        uint32_t lost = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+
+        if(lost) {
+            TraceRecord r;
+            r.timestamp = (uint32_t)bench_ticks();
+            r.event = TR_DROPPED;
+            r.core = (uint8_t)core;
+            r.level = TRACE_LVL_WARN;
+            r.arg0 = lost;
+            r.arg1 = (uint32_t)core;
+            trace_put_record(&r);
+        }
+
+        uint32_t tail = ring->tail;
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        while(tail != head) {
+            /* Satır bitmeden frame süresi dolacaksa sonraki boşluğa bırak */
+            if(deadline && timer_get_ticks() + TRACE_LINE_US > deadline) {
+                __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+                return;
+            }
+
+            TraceRecord r = ring->records[tail & (TRACE_RING_SIZE - 1)];
+            __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+            tail++;
+            trace_put_record(&r);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/* compositor.c - Katmanlı ekran çizimi ve saklı yüzeyler */
+#include <ui/compositor.h>
+#include <graphics.h>
+#include <fb.h>
+#include <mm.h>
+
+/* Tema sürümü: 0 hiç çizilmemiş katman demek */
+static uint32_t compositor_epoch = 1;
+
+void compositor_invalidate(void) {
+    compositor_epoch++;
+}
+
+/* Yüzeyi katmanın boyutuna getir; 0: hazır */
+static int layer_alloc(Layer *l) {
+    if(l->surf.pixels && l->surf.w == l->w && l->surf.h == l->h) return 0;
+
+    kfree(l->surf.pixels);
+    l->surf.pixels = (uint32_t *)kmalloc((size_t)l->w * l->h * FB_BYTES);
+    if(!l->surf.pixels) return -1;
+
+    l->surf.w = l->w;
+    l->surf.h = l->h;
+    l->surf.stride = l->w * FB_BYTES;
+    l->surf.format = SURFACE_FB;
+    return 0;
+}
+
+/* Katmanı ekran dışında çiz ve yüzeye al; 0: başarılı */
+static int layer_render(Layer *l, uint32_t key) {
+    if(layer_alloc(l) < 0) return -1;
+    if(graphics_offscreen_begin(l->x, l->y, l->w, l->h) < 0) return -1;
+
+    draw_rect(l->x, l->y, l->w, l->h, 0xFF000000);
+    l->draw();
+    graphics_offscreen_end(&l->surf);
+
+    /* displist blit'i gen'den ayırt eder */
+    l->surf.gen++;
+    l->drawn_key = key;
+    l->drawn_epoch = compositor_epoch;
+    l->drawn_w = GFX_WIDTH;
+    l->drawn_h = GFX_HEIGHT;
+    return 0;
+}
+
+void compositor_draw(Layer *layers, int count) {
+    for(int i = 0; i < count; i++) {
+        Layer *l = &layers[i];
+
+        if(l->kind == LAYER_DYNAMIC) {
+            l->draw();
+            continue;
+        }
+
+        uint32_t key = (l->kind == LAYER_CHROME && l->key) ? l->key() : 0;
+        int valid = l->surf.pixels &&
+                    l->drawn_epoch == compositor_epoch &&
+                    l->drawn_key == key &&
+                    l->drawn_w == GFX_WIDTH &&
+                    l->drawn_h == GFX_HEIGHT;
+
+        if(!valid && layer_render(l, key) < 0) {
+            l->draw();
+            continue;
+        }
+        blit(&l->surf, l->x, l->y);
+    }
+}
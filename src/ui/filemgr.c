@@ -7,6 +7,7 @@
 #include <fonts/fonts.h>
 #include <types.h>
 #include <hw.h>
+#include <mm.h>
 
 /* --- AYARLAR --- */
 #define ITEM_HEIGHT      50
@@ -56,8 +57,9 @@ static char view_filename[MAX_FM_NAME];
 /* Resim görüntüleme değişkenleri */
 #define MAX_IMG_WIDTH    640
 #define MAX_IMG_HEIGHT   480
-#define IMG_BUFFER_SIZE  (MAX_IMG_WIDTH * MAX_IMG_HEIGHT * 4)  /* BGRA */
-static uint8_t img_buffer[IMG_BUFFER_SIZE];
+#define IMG_BUFFER_SIZE  (MAX_IMG_WIDTH * MAX_IMG_HEIGHT * 4)  /* BGRA (framebuffer sırası) */
+static uint8_t *img_buffer = 0;  /* Görüntüleyici açıkken heap'ten ödünç */
+static Surface img_surface;      /* img_buffer'ın yüklü kısmı, blit kaynağı */
 static int img_width = 0;
 static int img_height = 0;
 static int img_loaded = 0;
@@ -70,6 +72,25 @@ static uint8_t bmp_header[64];
 
 /* --- YARDIMCI FONKSİYONLAR --- */
 
+/* Resim tamponunu ödünç al */
+static int img_buffer_acquire(void) {
+    if(!img_buffer) {
+        img_buffer = (uint8_t *)kmalloc(IMG_BUFFER_SIZE);
+    }
+    if(!img_buffer) {
+        uart_puts("[VIEWER] Resim tamponu ayrilamadi\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* Resim tamponunu geri ver (görüntüleyici kapandı) */
+static void img_buffer_release(void) {
+    kfree(img_buffer);
+    img_buffer = 0;
+    img_loaded = 0;
+}
+
 /* String kopyalama */
 static void str_copy(char *dest, const char *src, int max_len) {
     int i = 0;
@@ -354,10 +375,10 @@ static int open_bmp_file(const char *filename) {
             int src_idx = x * (bpp / 8);
             int dst_idx = (dest_y * MAX_IMG_WIDTH + x) * 4;
 
-            /* BMP: BGR(A) formatında */
-            img_buffer[dst_idx + 0] = bmp_row_buf[src_idx + 2];  /* R */
+            /* BMP: BGR(A) formatında, framebuffer ile aynı sıra */
+            img_buffer[dst_idx + 0] = bmp_row_buf[src_idx + 0];  /* B */
             img_buffer[dst_idx + 1] = bmp_row_buf[src_idx + 1];  /* G */
-            img_buffer[dst_idx + 2] = bmp_row_buf[src_idx + 0];  /* B */
+            img_buffer[dst_idx + 2] = bmp_row_buf[src_idx + 2];  /* R */
             img_buffer[dst_idx + 3] = (bpp == 32) ? bmp_row_buf[src_idx + 3] : 255;  /* A */
         }
     }
@@ -446,9 +467,9 @@ static int open_gif_file(const char *filename) {
     /* Arka planı temizle */
     for(int i = 0; i < width * height * 4; i += 4) {
         if(has_gct && bg_color < gct_size) {
-            img_buffer[i + 0] = gct[bg_color * 3 + 0];
-            img_buffer[i + 1] = gct[bg_color * 3 + 1];
-            img_buffer[i + 2] = gct[bg_color * 3 + 2];
+            img_buffer[i + 0] = gct[bg_color * 3 + 2];  /* B */
+            img_buffer[i + 1] = gct[bg_color * 3 + 1];  /* G */
+            img_buffer[i + 2] = gct[bg_color * 3 + 0];  /* R */
         } else {
             img_buffer[i + 0] = 0;
             img_buffer[i + 1] = 0;
@@ -473,10 +494,8 @@ static int open_gif_file(const char *filename) {
     return 0;
 }
 
-/* PNG dosyasını yükle (basit - sadece header ve boyut bilgisi) */
-/* PNG dosya okuma buffer'ı - static */
-#define PNG_FILE_MAX (300 * 1024)  /* 300KB max PNG dosya boyutu */
-static uint8_t png_file_buf[PNG_FILE_MAX];
+/* PNG dosyasını yükle */
+#define PNG_FILE_MAX (4 * 1024 * 1024)  /* 4MB max PNG dosya boyutu */
 
 static int open_png_file(const char *filename) {
     char full_path[MAX_FM_PATH];
@@ -511,6 +530,14 @@ static int open_png_file(const char *filename) {
         return -1;
     }
 
+    /* Dosya tamponu sadece decode süresince ödünç alınır */
+    uint8_t *png_file_buf = (uint8_t *)kmalloc(file_size ? file_size : 1);
+    if(!png_file_buf) {
+        uart_puts("[PNG] Out of memory\n");
+        fat32_close(fd);
+        return -1;
+    }
+
     /* Tüm dosyayı oku */
     uint32_t total_read = 0;
     while(total_read < file_size) {
@@ -526,12 +553,15 @@ static int open_png_file(const char *filename) {
 
     if(total_read < 8) {
         uart_puts("[PNG] File too small\n");
+        kfree(png_file_buf);
         return -1;
     }
 
     /* PNG decoder'ı çağır */
     int width, height;
-    if(png_decode(png_file_buf, total_read, img_buffer, MAX_IMG_WIDTH, MAX_IMG_HEIGHT, &width, &height) < 0) {
+    int result = png_decode(png_file_buf, total_read, img_buffer, MAX_IMG_WIDTH, MAX_IMG_HEIGHT, &width, &height);
+    kfree(png_file_buf);
+    if(result < 0) {
         uart_puts("[PNG] Decode failed\n");
         return -1;
     }
@@ -633,9 +663,9 @@ static int open_jpeg_file(const char *filename) {
     for(int y = 0; y < height; y++) {
         for(int x = 0; x < width; x++) {
             int idx = (y * MAX_IMG_WIDTH + x) * 4;
-            img_buffer[idx + 0] = (x * 100) / width;        /* R */
+            img_buffer[idx + 0] = 200;                       /* B */
             img_buffer[idx + 1] = (y * 100) / height;       /* G */
-            img_buffer[idx + 2] = 200;                       /* B */
+            img_buffer[idx + 2] = (x * 100) / width;        /* R */
             img_buffer[idx + 3] = 255;
         }
     }
@@ -649,6 +679,25 @@ static int open_jpeg_file(const char *filename) {
     return 0;
 }
 
+/* Resim aç: tamponu ödünç al, yükleme başarısızsa geri ver */
+static int open_image_file(int (*open_fn)(const char *), const char *filename) {
+    img_buffer_release();
+    if(img_buffer_acquire() < 0) return -1;
+
+    if(open_fn(filename) != 0) {
+        img_buffer_release();
+        return -1;
+    }
+
+    img_surface.w = img_width;
+    img_surface.h = img_height;
+    img_surface.stride = MAX_IMG_WIDTH * 4;
+    img_surface.format = SURFACE_ARGB8888;
+    img_surface.pixels = (uint32_t *)img_buffer;
+    img_surface.gen++;
+    return 0;
+}
+
 /* Mevcut dizini yükle */
 static void load_directory(void) {
     uart_puts("[FILEMGR] load_directory: ");
@@ -851,17 +900,8 @@ static void draw_image_viewer(void) {
     if(offset_x < 0) offset_x = 0;
     if(offset_y < 0) offset_y = 0;
 
-    /* Resmi çiz */
-    for(int y = 0; y < img_height && (y + offset_y) < SCREEN_HEIGHT - FOOTER_HEIGHT; y++) {
-        for(int x = 0; x < img_width && (x + offset_x) < SCREEN_WIDTH; x++) {
-            int idx = (y * MAX_IMG_WIDTH + x) * 4;
-            uint8_t r = img_buffer[idx + 0];
-            uint8_t g = img_buffer[idx + 1];
-            uint8_t b = img_buffer[idx + 2];
-            uint32_t color = 0xFF000000 | (r << 16) | (g << 8) | b;
-            draw_pixel(x + offset_x, y + offset_y, color);
-        }
-    }
+    /* Resmi çiz (footer altında kalan kısım footer ile örtülür) */
+    blit(&img_surface, offset_x, offset_y);
 
     /* Footer */
     int footer_y = SCREEN_HEIGHT - FOOTER_HEIGHT;
@@ -1179,8 +1219,7 @@ void filemgr_enter(void) {
             uart_puts(name);
             uart_puts("\n");
 
-            img_loaded = 0;
-            if(open_bmp_file(name) == 0) {
+            if(open_image_file(open_bmp_file, name) == 0) {
                 fm_state = FM_STATE_IMAGE;
             }
         } else if(has_extension(name, ".gif") || has_extension(name, ".GIF")) {
@@ -1189,8 +1228,7 @@ void filemgr_enter(void) {
             uart_puts(name);
             uart_puts("\n");
 
-            img_loaded = 0;
-            if(open_gif_file(name) == 0) {
+            if(open_image_file(open_gif_file, name) == 0) {
                 fm_state = FM_STATE_IMAGE;
             }
         } else if(has_extension(name, ".png") || has_extension(name, ".PNG")) {
@@ -1199,8 +1237,7 @@ void filemgr_enter(void) {
             uart_puts(name);
             uart_puts("\n");
 
-            img_loaded = 0;
-            if(open_png_file(name) == 0) {
+            if(open_image_file(open_png_file, name) == 0) {
                 fm_state = FM_STATE_IMAGE;
             }
         } else if(has_extension(name, ".jpg") || has_extension(name, ".JPG") ||
@@ -1210,8 +1247,7 @@ void filemgr_enter(void) {
             uart_puts(name);
             uart_puts("\n");
 
-            img_loaded = 0;
-            if(open_jpeg_file(name) == 0) {
+            if(open_image_file(open_jpeg_file, name) == 0) {
                 fm_state = FM_STATE_IMAGE;
             }
         }
@@ -1228,7 +1264,7 @@ void filemgr_back(void) {
     /* Resim görüntüleme modundaysak kapat */
     if(fm_state == FM_STATE_IMAGE) {
         fm_state = FM_STATE_READY;
-        img_loaded = 0;
+        img_buffer_release();
         return;
     }
 
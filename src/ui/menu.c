@@ -1,6 +1,7 @@
 /* src/ui/menu.c - Optimized Animation Logic */
 #include <ui/menu.h>
 #include <ui/theme.h>
+#include <ui/compositor.h>
 #include <graphics.h>
 #include <fonts/fonts.h>
 #include <drivers/timer.h>
@@ -310,21 +311,30 @@ void menu_draw_content(void) {
 
 
 
-void menu_render(void) {
-    if(!g_menu.initialized) return;
+/* Arka plan + içerik: düz dolgu kopyadan ucuz, katman dinamik */
+static void menu_draw_body(void) {
+    draw_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0xFF1A1A1A);
+    menu_draw_content();
+}
 
-    /* 1. Arka planı temizle */
-    draw_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0xFF1A1A1A); 
+/* Sidebar sadece seçim ve dikey scroll ile değişir */
+static uint32_t menu_sidebar_key(void) {
+    union { float f; uint32_t u; } scroll = { g_menu.scroll_y };
+    return scroll.u * 2654435761u + (uint32_t)g_menu.selected_category * 31 + (uint32_t)g_menu.category_count;
+}
 
-    /* 2. ÖNCE İçeriği çiz */
-    /* Böylece içerik kayarken Sidebar'ın altına girer */
-    menu_draw_content();
+static Layer menu_layers[] = {
+    { .kind = LAYER_DYNAMIC, .draw = menu_draw_body },
+    { .kind = LAYER_CHROME, .x = 0, .y = 51, .w = 201, .h = SCREEN_HEIGHT - 51,
+      .draw = menu_draw_sidebar, .key = menu_sidebar_key },
+    { .kind = LAYER_STATIC, .x = 0, .y = 0, .w = SCREEN_WIDTH, .h = 51, .draw = menu_draw_header }
+};
 
-    /* 3. SONRA Sidebar'ı çiz (Üste biner) */
-    menu_draw_sidebar();
+void menu_render(void) {
+    if(!g_menu.initialized) return;
 
-    /* 4. En üste Header ve Footer */
-    menu_draw_header();
+    /* İçerik önce: kayarken Sidebar'ın altına girer; Header en üstte */
+    compositor_draw(menu_layers, 3);
     
 
     __asm__ volatile("dsb sy");
@@ -1,5 +1,7 @@
 /* theme.c - Theme system implementation */
 #include <ui/theme.h>
+#include <ui/compositor.h>
+#include <graphics.h>
 
 /* Mevcut aktif tema */
 Theme g_theme;
@@ -170,6 +172,19 @@ const Theme THEME_PRESET_MODERN_DARK = {
 
 /* --- Tema Fonksiyonları --- */
 
+/* Tema yalnızca uint32_t renklerden oluşur: her renk bir palet yuvası */
+#define THEME_COLOR_COUNT   (sizeof(Theme) / sizeof(uint32_t))
+_Static_assert(THEME_COLOR_COUNT <= PAL_THEME_COUNT, "Tema renkleri palet yuvalarina sigmiyor");
+
+/*
+ * 8 bpp'de tema renklerini kendi yuvalarına yaz: tema rengiyle çizilen
+ * her şey birebir renkte çıkar, tema değişimi tek palet güncellemesidir.
+ * Diğer modlarda graphics_set_palette bir şey yapmaz.
+ */
+static void theme_apply_palette(void) {
+    graphics_set_palette(PAL_THEME_FIRST, THEME_COLOR_COUNT, (const uint32_t *)&g_theme);
+}
+
 void theme_init(void) {
     /* Varsayılan tema: Modern Dark (Nötr) */
     theme_set_custom(&THEME_PRESET_MODERN_DARK);
@@ -193,10 +208,14 @@ void theme_set(ThemePreset preset) {
             g_theme = THEME_PRESET_RETROARCH_DARK;
             break;
     }
+    theme_apply_palette();
+    compositor_invalidate();
 }
 
 void theme_set_custom(const Theme *custom) {
     g_theme = *custom;
+    theme_apply_palette();
+    compositor_invalidate();
 }
 
 Theme *theme_get(void) {
@@ -2,6 +2,8 @@
 #include <ui/transition.h>
 #include <ui/theme.h>
 #include <graphics.h>
+#include <task.h>
+#include <blend.h>
 
 /* Global geçiş durumu */
 Transition g_transition;
@@ -210,30 +212,30 @@ float transition_get_scale(void) {
     return g_transition.scale;
 }
 
-void transition_draw_fade_overlay(void) {
-    if(g_transition.type != TRANS_FADE || g_transition.fade_alpha == 0) {
-        return;
-    }
+static void fade_rows(int y0, int y1, void *arg) {
+    uint8_t alpha = *(uint8_t *)arg;
 
-    /* Basit alpha blend için her satırı çiz (draw_buffer kullan) */
-    for(int y = 0; y < SCREEN_HEIGHT; y++) {
-        for(int x = 0; x < SCREEN_WIDTH; x++) {
-            /* Mevcut piksel rengini al ve karıştır */
-            uint32_t offset = (y * SCREEN_WIDTH * 4) + (x * 4);
-            uint32_t *pixel_addr = (uint32_t *)(draw_buffer + offset);
-            uint32_t current = *pixel_addr;
-
-            /* Alpha blend */
-            uint8_t alpha = g_transition.fade_alpha;
-            uint8_t inv_alpha = 255 - alpha;
+    /* Siyaha doğru karıştır: c * (255 - alpha) / 255 */
+    for(int y = y0; y < y1; y++) {
+        fb_pixel_t *row = (fb_pixel_t *)(draw_buffer + y * FB_STRIDE);
+        fb_span_blend(row, GFX_WIDTH, 0xFF000000, alpha);
+    }
+}
 
-            uint8_t r = (uint8_t)(((current >> 16) & 0xFF) * inv_alpha / 255);
-            uint8_t g = (uint8_t)(((current >> 8) & 0xFF) * inv_alpha / 255);
-            uint8_t b = (uint8_t)((current & 0xFF) * inv_alpha / 255);
+void transition_draw_fade_overlay(void) {
+    uint8_t alpha = (g_transition.type == TRANS_FADE) ? g_transition.fade_alpha : 0;
 
-            *pixel_addr = 0xFF000000 | (r << 16) | (g << 8) | b;
-        }
+    /* 8 bpp: solma sadece palet güncellemesi (alpha 0 asıl paleti geri yükler) */
+    if(graphics_palette_blend(0xFF000000, alpha) == 0) {
+        return;
     }
+    if(alpha == 0) {
+        return;
+    }
+
+    /* Basit alpha blend, satırlar çekirdeklere dağıtılır (draw_buffer kullan) */
+    graphics_mark_dirty(0, 0, GFX_WIDTH, GFX_HEIGHT);
+    parallel_for(0, GFX_HEIGHT, 32, fade_rows, &alpha);
 }
 
 void transition_cancel(void) {
@@ -0,0 +1,154 @@
+/*
+ * blend_test.c - Alpha karıştırma aritmetiğinin host testi (make test-blend)
+ *
+ * src/lib/blend.S host'ta çalıştırılamaz; onun yerine NEON dizisinin
+ * 16 bitlik şerit modeli kurulur ve şunlar doğrulanır:
+ *   - Model (UMULL/ADD, URSRA #8, RSHRN #8) tüm t = fg*a + bg*(255-a)
+ *     için tam round(t/255) verir ve 16 bitlik şeritte taşmaz.
+ *   - blend_div255 / blend_pixel (skaler yol) aynı sonucu verir.
+ *   - Eski kesen /255 (blend_colors) ile fark 0 veya +1'dir.
+ *   - BLEND_SCALAR span'leri (src/kernel/blend.c) her uzunlukta modelle
+ *     bit bit aynıdır: blend_span, blend_span_glass, blend_span_over.
+ * blend.S değiştirildiğinde model de aynı diziyi izleyecek şekilde
+ * güncellenmelidir.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <blend.h>
+
+static int failures;
+
+#define CHECK(cond, ...) do { \
+    if(!(cond)) { \
+        if(failures++ < 10) { printf("HATA: " __VA_ARGS__); printf("\n"); } \
+    } \
+} while(0)
+
+/* URSRA #8: t + ((t + 128) >> 8), yuvarlama geniş, toplama 16 bit şeritte */
+static uint32_t lane_ursra8(uint32_t t) {
+    uint32_t r = t + ((t + 128) >> 8);
+    CHECK(r <= 0xFFFF, "URSRA tasmasi t=%u", t);
+    return r & 0xFFFF;
+}
+
+/* RSHRN #8: (t + 128) >> 8, 8 bite daraltılır */
+static uint32_t lane_rshrn8(uint32_t t) {
+    uint32_t r = (t + 128) >> 8;
+    CHECK(r <= 0xFF, "RSHRN daraltma kaybi t=%u", t);
+    return r & 0xFF;
+}
+
+/* BLEND16/BLEND8 şeridi: UMULL c*(255-a), ADD fg*a, URSRA, RSHRN */
+static uint32_t lane_blend(uint32_t c, uint32_t fg, uint32_t a) {
+    uint32_t t = c * (255 - a) + fg * a;
+    CHECK(t <= 0xFFFF, "UMULL+ADD tasmasi t=%u", t);
+    return lane_rshrn8(lane_ursra8(t));
+}
+
+/* LIGHTEN şeridi: c + (~c >> 2) */
+static uint32_t lane_lighten(uint32_t c) {
+    return c + ((~c & 0xFF) >> 2);
+}
+
+/* OVER16/OVER8 şeridi: UQADD(s, round(d*(255-sa)/255)) */
+static uint32_t lane_over(uint32_t d, uint32_t s, uint32_t sa) {
+    uint32_t r = s + lane_rshrn8(lane_ursra8(d * (255 - sa)));
+    return r > 255 ? 255 : r;
+}
+
+static uint32_t model_pixel(uint32_t bg, uint32_t fg, uint32_t a, int glass) {
+    uint32_t out = 0xFF000000;
+    for(int sh = 0; sh < 24; sh += 8) {
+        uint32_t c = (bg >> sh) & 0xFF;
+        if(glass) c = lane_lighten(c);
+        out |= lane_blend(c, (fg >> sh) & 0xFF, a) << sh;
+    }
+    return out;
+}
+
+static uint32_t model_over(uint32_t bg, uint32_t src) {
+    uint32_t out = 0xFF000000;
+    for(int sh = 0; sh < 24; sh += 8) {
+        out |= lane_over((bg >> sh) & 0xFF, (src >> sh) & 0xFF, src >> 24) << sh;
+    }
+    return out;
+}
+
+/* Tüm (bg, fg, a) üçlüleri: tek kanal yeter, kanallar bağımsız */
+static void test_exhaustive(void) {
+    uint32_t plus_one = 0;
+
+    for(uint32_t a = 0; a < 256; a++) {
+        for(uint32_t fg = 0; fg < 256; fg++) {
+            for(uint32_t bg = 0; bg < 256; bg++) {
+                uint32_t t = fg * a + bg * (255 - a);
+                uint32_t exact = (2 * t + 255) / 510;       /* round(t/255), .5 yok */
+                uint32_t old = t / 255;                     /* Eski blend_colors */
+                uint32_t lane = lane_blend(bg, fg, a);
+
+                CHECK(lane == exact, "model t=%u: %u != %u", t, lane, exact);
+                CHECK(blend_div255(t) == exact, "blend_div255(%u) = %u != %u", t, blend_div255(t), exact);
+                CHECK(exact == old || exact == old + 1, "eski kodla fark t=%u: %u vs %u", t, exact, old);
+                if(exact != old) plus_one++;
+            }
+        }
+        uint32_t bg = a * 0x010203, fg = ~a * 0x030201;
+        CHECK(blend_pixel(bg, fg, (uint8_t)a) == model_pixel(bg, fg, a, 0),
+              "blend_pixel a=%u", a);
+    }
+    printf("blend_test: 16777216 uclu tam yuvarlama, eski koddan +1: %u\n", plus_one);
+}
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state;
+}
+
+/* Span'ler: 16/8/1'lik kuyrukların hepsini kapsayan uzunluklar */
+static void test_spans(void) {
+    uint32_t buf[80], ref[80], src[80];
+
+    for(int iter = 0; iter < 2000; iter++) {
+        int n = iter % 70;
+        uint32_t color = rng();
+        uint8_t alpha = (uint8_t)(iter < 512 ? iter & 0xFF : rng() >> 24);
+
+        for(int i = 0; i < 80; i++) buf[i] = rng();
+        for(int i = 0; i < 80; i++) ref[i] = i < n ? model_pixel(buf[i], color, alpha, 0) : buf[i];
+        blend_span(buf, n, color, alpha);
+        for(int i = 0; i < 80; i++) CHECK(buf[i] == ref[i], "blend_span n=%d i=%d", n, i);
+
+        for(int i = 0; i < 80; i++) buf[i] = rng();
+        for(int i = 0; i < 80; i++) ref[i] = i < n ? model_pixel(buf[i], color, alpha, 1) : buf[i];
+        blend_span_glass(buf, n, color, alpha);
+        for(int i = 0; i < 80; i++) CHECK(buf[i] == ref[i], "blend_span_glass n=%d i=%d", n, i);
+
+        /* Önçarpımlı kaynak: kanal <= alpha */
+        for(int i = 0; i < 80; i++) {
+            uint32_t a = rng() >> 24, c = rng();
+            uint32_t r = ((c >> 16) & 0xFF) * a / 255, g = ((c >> 8) & 0xFF) * a / 255, b = (c & 0xFF) * a / 255;
+            src[i] = (a << 24) | (r << 16) | (g << 8) | b;
+            buf[i] = rng();
+        }
+        for(int i = 0; i < 80; i++) {
+            ref[i] = i < n ? model_over(buf[i], src[i]) : buf[i];
+            if(i < n) CHECK(blend_pixel_over(buf[i], src[i]) == ref[i], "blend_pixel_over i=%d", i);
+        }
+        blend_span_over(buf, src, n);
+        for(int i = 0; i < 80; i++) CHECK(buf[i] == ref[i], "blend_span_over n=%d i=%d", n, i);
+    }
+}
+
+int main(void) {
+    test_exhaustive();
+    test_spans();
+
+    if(failures) {
+        printf("blend_test: %d hata\n", failures);
+        return 1;
+    }
+    printf("blend_test: tamam\n");
+    return 0;
+}
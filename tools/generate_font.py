@@ -278,6 +278,9 @@ void {output_name}_draw_char(int x, int y, char c, uint32_t color) {{
     const {output_name}_Glyph* glyph = &{output_name}_glyphs[idx];
     const uint8_t* pixels = &{output_name}_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, {macro_prefix}_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
@@ -309,6 +312,9 @@ void {output_name}_draw_turkish_char(int x, int y, int tr_index, uint32_t color)
     const {output_name}_Glyph* glyph = &{output_name}_turkish_glyphs[tr_index];
     const uint8_t* pixels = &{output_name}_pixels[glyph->offset];
 
+    /* Clip dışında kalan glif atlanır */
+    if(!graphics_clip_test(x, y, glyph->width, {macro_prefix}_HEIGHT)) return;
+
     uint8_t r = (color >> 16) & 0xFF;
     uint8_t g = (color >> 8) & 0xFF;
     uint8_t b = color & 0xFF;
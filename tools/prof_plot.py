@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+PROF=1 çekirdeğinin UART çıktısındaki profil satırlarını çözer ve çizer
+Kullanım:
+    python3 prof_plot.py uart.log              # özet tablo + grafik
+    python3 prof_plot.py uart.log -o prof.png  # grafiği dosyaya kaydet
+    cat /dev/ttyUSB0 | python3 prof_plot.py -  # canlı log (Ctrl+C ile bitir)
+Gerekli (grafik için): pip install matplotlib
+
+Satır biçimi (include/prof.h):
+    N,<id>,<ad>
+    F,<frame>,<frame_sayisi>,<toplam_cycle>
+    P,<frame>,<id>,<cagri>,<cycle>,<l1d_refill>,<komut>
+    T,<frame>,<sutun>,<satir>,<ns/frame>...   (displist karo raster süreleri)
+"""
+
+import sys
+import argparse
+from collections import defaultdict
+
+
+def parse(lines):
+    names = {}
+    intervals = []          # (frame, frame_sayisi, toplam_cycle)
+    samples = defaultdict(dict)  # frame -> id -> (cagri, cycle, l1d, komut)
+    tiles = []              # (sutun, satir, [ns/frame ...])
+
+    for line in lines:
+        parts = line.strip().split(",")
+        if not parts or parts[0] not in ("N", "F", "P", "T"):
+            continue  # Diğer UART logları
+        try:
+            if parts[0] == "N" and len(parts) >= 3:
+                names[int(parts[1])] = ",".join(parts[2:])
+            elif parts[0] == "F" and len(parts) == 4:
+                intervals.append(tuple(int(p) for p in parts[1:4]))
+            elif parts[0] == "P" and len(parts) == 7:
+                frame, zid, calls, cyc, l1d, inst = (int(p) for p in parts[1:7])
+                samples[frame][zid] = (calls, cyc, l1d, inst)
+            elif parts[0] == "T" and len(parts) >= 4:
+                cols, rows = int(parts[2]), int(parts[3])
+                values = [int(p) for p in parts[4:]]
+                if len(values) == cols * rows:
+                    tiles.append((cols, rows, values))
+        except ValueError:
+            continue  # Yarım kalmış satır
+
+    return names, intervals, samples, tiles
+
+
+def tile_average(tiles):
+    """Tüm T satırlarının ortalaması: (sutun, satir, [ns/frame])"""
+    cols, rows, _ = tiles[-1]
+    same = [v for c, r, v in tiles if (c, r) == (cols, rows)]
+    avg = [sum(v[i] for v in same) / len(same) for i in range(cols * rows)]
+    return cols, rows, avg
+
+
+def tile_summary(tiles, top=8):
+    if not tiles:
+        return
+    cols, rows, avg = tile_average(tiles)
+    total = sum(avg)
+    print(f"\nKaro raster ({cols}x{rows}), toplam {total / 1000:.1f} us/frame, en sıcak karolar:")
+    print(f"{'karo':<10}{'piksel':>14}{'us/frame':>11}{'%':>7}")
+    for i in sorted(range(len(avg)), key=lambda i: -avg[i])[:top]:
+        if avg[i] <= 0:
+            break
+        x, y = (i % cols) * 64, (i // cols) * 64
+        pct = 100.0 * avg[i] / total if total else 0.0
+        print(f"{i % cols},{i // cols:<8}{f'({x},{y})':>14}{avg[i] / 1000:>11.1f}{pct:>7.1f}")
+
+
+def summary(names, intervals, samples):
+    total_frames = sum(n for _, n, _ in intervals)
+    total_cycles = sum(c for _, _, c in intervals)
+    if total_frames == 0:
+        print("Profil satırı bulunamadı (PROF=1 ile derlendi mi?)")
+        return
+
+    totals = defaultdict(lambda: [0, 0, 0, 0])
+    for zones in samples.values():
+        for zid, vals in zones.items():
+            for i, v in enumerate(vals):
+                totals[zid][i] += v
+
+    print(f"{total_frames} frame, ortalama {total_cycles // total_frames} cycle/frame\n")
+    print(f"{'bolge':<16}{'cycle/frame':>14}{'%':>8}{'cagri/frame':>13}"
+          f"{'L1D refill/fr':>15}{'IPC':>7}")
+    for zid in sorted(totals, key=lambda z: -totals[z][1]):
+        calls, cyc, l1d, inst = totals[zid]
+        name = names.get(zid, f"#{zid}")
+        pct = 100.0 * cyc / total_cycles if total_cycles else 0.0
+        ipc = inst / cyc if cyc else 0.0
+        print(f"{name:<16}{cyc // total_frames:>14}{pct:>8.1f}"
+              f"{calls / total_frames:>13.1f}{l1d // total_frames:>15}{ipc:>7.2f}")
+
+
+def plot_tiles(tiles, output):
+    import matplotlib.pyplot as plt
+
+    cols, rows, avg = tile_average(tiles)
+    grid = [[avg[r * cols + c] / 1000 for c in range(cols)] for r in range(rows)]
+
+    fig, ax = plt.subplots(figsize=(8, 6))
+    im = ax.imshow(grid, cmap="inferno", extent=(0, cols * 64, rows * 64, 0))
+    fig.colorbar(im, ax=ax, label="us / frame")
+    ax.set_title("displist karo raster süresi (64x64)")
+    fig.tight_layout()
+
+    if output:
+        base, dot, ext = output.rpartition(".")
+        tile_out = f"{base}_karo.{ext}" if dot else f"{output}_karo"
+        fig.savefig(tile_out, dpi=120)
+        print(f"Karo grafiği kaydedildi: {tile_out}")
+
+
+def plot(names, intervals, samples, output):
+    try:
+        import matplotlib
+        if output:
+            matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        print("\nmatplotlib yok, grafik atlandı")
+        return False
+
+    frames = [f for f, _, _ in intervals]
+    per_frame = {f: n for f, n, _ in intervals}
+    zone_ids = sorted({z for zs in samples.values() for z in zs})
+
+    fig, ax = plt.subplots(figsize=(12, 5))
+    bottom = [0.0] * len(frames)
+    for zid in zone_ids:
+        values = [samples[f].get(zid, (0, 0, 0, 0))[1] / per_frame[f] for f in frames]
+        ax.bar(frames, values, bottom=bottom, label=names.get(zid, f"#{zid}"),
+               width=max(1, per_frame[frames[0]] * 0.8) if frames else 1)
+        bottom = [b + v for b, v in zip(bottom, values)]
+
+    total = [c / n for _, n, c in intervals]
+    ax.plot(frames, total, color="black", linewidth=1, label="toplam")
+    ax.set_xlabel("frame")
+    ax.set_ylabel("cycle / frame")
+    ax.set_title("emConOs frame profili (çekirdek 0)")
+    ax.legend(loc="upper right", fontsize="small")
+    fig.tight_layout()
+
+    if output:
+        fig.savefig(output, dpi=120)
+        print(f"\nGrafik kaydedildi: {output}")
+    return True
+
+
+def show(output):
+    if not output:
+        import matplotlib.pyplot as plt
+        plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="emConOs PMU profil çizici")
+    parser.add_argument("log", help="UART log dosyası ('-' = stdin)")
+    parser.add_argument("-o", "--output", help="Grafiği dosyaya kaydet (png/svg)")
+    parser.add_argument("--no-plot", action="store_true", help="Sadece tablo")
+    args = parser.parse_args()
+
+    if args.log == "-":
+        lines = []
+        try:
+            for line in sys.stdin:
+                lines.append(line)
+        except KeyboardInterrupt:
+            pass
+    else:
+        with open(args.log, errors="replace") as f:
+            lines = f.readlines()
+
+    names, intervals, samples, tiles = parse(lines)
+    summary(names, intervals, samples)
+    tile_summary(tiles)
+    if not args.no_plot and intervals:
+        if plot(names, intervals, samples, args.output):
+            if tiles:
+                plot_tiles(tiles, args.output)
+            show(args.output)
+
+
+if __name__ == "__main__":
+    main()
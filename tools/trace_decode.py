@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+emConOs UART çıktısındaki ikili iz kayıtlarını okunabilir metne çevirir
+Kullanım:
+    python3 trace_decode.py uart.log                 # tüm kayıtlar
+    python3 trace_decode.py uart.log --level 2       # sadece hata + uyarı
+    cat /dev/ttyUSB0 | python3 trace_decode.py -     # canlı log (Ctrl+C ile bitir)
+
+Satır biçimi (src/kernel/trace.c):
+    ~~<frekans hex>                       açılışta bir kez (CNTFRQ_EL0)
+    ~<ts><event|core<<16|level<<24><a0><a1>   her biri 8 hex hane
+Olay adları ve biçimleri include/trace.h içindeki TraceEvent yorumlarından
+okunur (%0 = a0, %1 = a1). Diğer UART satırları olduğu gibi geçirilir.
+"""
+
+import os
+import re
+import sys
+import argparse
+
+LEVELS = {1: "HATA", 2: "UYARI", 3: "BILGI", 4: "DEBUG"}
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "include", "trace.h")
+
+
+def load_events(path):
+    """trace.h'deki enum'dan {id: (ad, biçim)} tablosu çıkar"""
+    events = {}
+    with open(path, errors="replace") as f:
+        text = f.read()
+
+    body = text[text.index("typedef enum"):text.index("} TraceEvent;")]
+    next_id = 0
+    for line in body.splitlines():
+        m = re.match(r"\s*(TR_\w+)\s*(?:=\s*(0x[0-9A-Fa-f]+|\d+))?\s*,\s*"
+                     r"(?:/\*\s*(.*?)\s*\*/)?", line)
+        if not m:
+            continue
+        name, value, fmt = m.groups()
+        if value is not None:
+            next_id = int(value, 0)
+        events[next_id] = (name, fmt or name)
+        next_id += 1
+    return events
+
+
+def format_event(fmt, a0, a1):
+    def arg(m):
+        v = a0 if m.group(1) == "0" else a1
+        return f"0x{v:X}" if v > 9 else str(v)
+    return re.sub(r"%([01])", arg, fmt)
+
+
+def decode(lines, events, max_level, raw_other):
+    freq = 0
+    last_ts = None
+    base = 0          # 32-bit zaman damgası taşmaları
+
+    for line in lines:
+        line = line.strip()
+        if line.startswith("~~"):
+            try:
+                freq = int(line[2:10], 16)
+            except ValueError:
+                pass
+            last_ts = None
+            base = 0
+            continue
+        if not line.startswith("~") or len(line) < 33:
+            if raw_other and line:
+                print(f"  | {line}")
+            continue
+
+        try:
+            ts, info, a0, a1 = (int(line[1 + 8 * i:9 + 8 * i], 16) for i in range(4))
+        except ValueError:
+            continue  # Yarım kalmış satır
+
+        event = info & 0xFFFF
+        core = (info >> 16) & 0xFF
+        level = (info >> 24) & 0xFF
+        if max_level and level > max_level:
+            continue
+
+        # Kayıtlar çekirdek başına sıralı dökülür; büyük geri sıçrama = taşma
+        if last_ts is not None and ts < last_ts and last_ts - ts > 0x80000000:
+            base += 1 << 32
+        last_ts = ts
+        full = base + ts
+
+        when = f"{full / freq:12.6f}s" if freq else f"{full:>14}"
+        name, fmt = events.get(event, (f"#{event}", f"olay {event} a0=%0 a1=%1"))
+        print(f"{when} c{core} {LEVELS.get(level, str(level)):<5} "
+              f"{format_event(fmt, a0, a1)}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="emConOs iz halkası çözücü")
+    parser.add_argument("log", help="UART log dosyası ('-' = stdin)")
+    parser.add_argument("--header", default=DEFAULT_HEADER,
+                        help="Olay tanımları (varsayılan include/trace.h)")
+    parser.add_argument("--level", type=int, default=0,
+                        help="Bu seviyeden ayrıntılı kayıtları gizle (1-4)")
+    parser.add_argument("--all", action="store_true",
+                        help="İz dışı UART satırlarını da göster")
+    args = parser.parse_args()
+
+    events = load_events(args.header)
+
+    if args.log == "-":
+        try:
+            decode(sys.stdin, events, args.level, args.all)
+        except KeyboardInterrupt:
+            pass
+    else:
+        with open(args.log, errors="replace") as f:
+            decode(f, events, args.level, args.all)
+
+
+if __name__ == "__main__":
+    main()